@@ -1,4 +1,3 @@
-
 /// Copyright 2016  Thomas E. Vaughan
 ///
 /// The present software is redistributable under the terms of the GNU LESSER
@@ -6,7 +5,8 @@
 /// along with the software.
 ///
 /// \file  basis.cpp
-/// \brief Definition of linreg::polynomial_basis, linreg::fourier_basis.
+/// \brief Definition of linreg::basic_polynom_basis,
+///        linreg::basic_fourier_basis.
 
 #include <cmath> // for cos(), sin()
 #include "basis.hpp"
@@ -14,28 +14,61 @@
 using namespace Eigen;
 using namespace linreg;
 
-VectorXd polynom_basis::operator()(double const x) const
+template <typename T>
+typename basic_polynom_basis<T>::vector
+basic_polynom_basis<T>::operator()(T const x) const
 {
    unsigned const sz = size();
-   VectorXd result(sz);
-   result(0) = 1.0;
+   vector result(sz);
+   result(0) = T(1);
    for (unsigned i = 1; i < sz; ++i) {
       result(i) = result(i - 1) * x;
    }
    return result;
 }
 
-VectorXd fourier_basis::operator()(double const x) const
+template <typename T>
+void basic_polynom_basis<T>::fill_design(Ref<vector const> const &x,
+                                         Ref<matrix> B) const
 {
    unsigned const sz = size();
-   VectorXd result(sz);
-   result(0) = 1.0;
+   B.col(0).setOnes();
+   for (unsigned j = 1; j < sz; ++j) {
+      B.col(j) = B.col(j - 1).cwiseProduct(x);
+   }
+}
+
+template <typename T>
+typename basic_fourier_basis<T>::vector
+basic_fourier_basis<T>::operator()(T const x) const
+{
+   unsigned const sz = size();
+   vector result(sz);
+   result(0) = T(1);
    for (unsigned i = 1; i < sz; i += 2) {
       unsigned const j = (i + 1) / 2;
-      double const k = j * angfreq_;
+      T const k = j * angfreq_;
       result(i + 0) = cos(k * x);
       result(i + 1) = sin(k * x);
    }
    return result;
 }
 
+template <typename T>
+void basic_fourier_basis<T>::fill_design(Ref<vector const> const &x,
+                                         Ref<matrix> B) const
+{
+   unsigned const sz = size();
+   B.col(0).setOnes();
+   for (unsigned i = 1; i < sz; i += 2) {
+      unsigned const j = (i + 1) / 2;
+      T const k = j * angfreq_;
+      B.col(i + 0) = (k * x.array()).cos();
+      B.col(i + 1) = (k * x.array()).sin();
+   }
+}
+
+template struct linreg::basic_polynom_basis<float>;
+template struct linreg::basic_polynom_basis<double>;
+template class linreg::basic_fourier_basis<float>;
+template class linreg::basic_fourier_basis<double>;
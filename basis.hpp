@@ -8,44 +8,72 @@
 /// \file  basis.hpp
 ///
 /// \brief Definition of linreg::basis; declaration of linreg::polynom_basis,
-///        linreg::fourier_basis.
+///        linreg::fourier_basis, linreg::design_matrix().
 
 #ifndef LINREG_BASIS_HPP
 #define LINREG_BASIS_HPP
 
 #include <deque>      // for deque<>
-#include <Eigen/Core> // for VectorXd
+#include <cmath>      // for atan()
+#include <Eigen/Core> // for Matrix, Ref
 
 namespace linreg
 {
-   template <typename PF>
+   template <typename PF, typename T>
    class basis;
 
-   template <typename PF>
-   basis<PF> make_basis(PF p);
+   template <typename PF, typename T = double>
+   basis<PF, T> make_basis(PF p);
 
-   template <typename PF, typename... Targs>
-   basis<PF> make_basis(PF p, Targs... Fargs);
+   template <typename PF, typename T = double, typename... Targs>
+   basis<PF, T> make_basis(PF p, Targs... Fargs);
 
    /// Abstract base class for every type of basis.
    ///
-   /// Each basis type must provide an operator() that takes a double x and
+   /// Each basis type must provide an operator() that takes a scalar x and
    /// returns a vector of values, each corresponding to a different basis
    /// function evaluated at the same x.
    ///
    /// Also, each basis type must report the size of the vector that will be
    /// returned by operator().
-   struct abstract_basis {
+   ///
+   /// \tparam T  Scalar type, float or double, of abscissa and of value of
+   ///            each basis function.
+   template <typename T>
+   struct basic_abstract_basis {
+      typedef T scalar;                                  ///< Scalar type.
+      typedef Eigen::Matrix<T, Eigen::Dynamic, 1> vector; ///< Column vector.
+      typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> matrix; ///< Matrix.
+
       /// \return Value of each basis function at given value of its argument.
-      virtual Eigen::VectorXd operator()(double const x) const = 0;
+      virtual vector operator()(T const x) const = 0;
 
       /// \return Number of elements in vector returned by operator().
       virtual unsigned size() const = 0;
 
+      /// Evaluate every basis function at every abscissa. The default
+      /// implementation calls operator() once per abscissa; a standard basis
+      /// overrides it to fill each column at once, so that the evaluation is
+      /// vectorized across abscissae.
+      ///
+      /// \param x  Abscissae, one for each data point.
+      /// \param B  Design matrix, already of size x.size() by size(); on
+      ///           return, row i is (*this)(x(i)).
+      virtual void fill_design(Eigen::Ref<vector const> const &x,
+                               Eigen::Ref<matrix> B) const
+      {
+         for (unsigned i = 0; i < x.size(); ++i) {
+            B.row(i) = (*this)(x(i));
+         }
+      }
+
       /// Make sure that descendant's destructor is called.
-      virtual ~abstract_basis() = default;
+      virtual ~basic_abstract_basis() = default;
    };
 
+   typedef basic_abstract_basis<float> abstract_basis_f; ///< Single precision.
+   typedef basic_abstract_basis<double> abstract_basis;  ///< Double precision.
+
    /// General, custom collection of basis functions for a linear regression.
    /// An instance of basis can be used when a user-defined collection of basis
    /// functions is needed. For a standard basis, such as the polynomial basis
@@ -53,14 +81,18 @@ namespace linreg
    ///
    /// \tparam PF  Type of pointer to function. Typically, an instance of PF
    ///             should be either a regular C-style pointer to a global
-   ///             function, which takes a double and returns a double, or an
-   ///             instance of std::shared_ptr<F>, where type F is a class that
-   ///             overloads operator() to take double and return double.
-   ///             In any event, an instance pf of PF should return a double
-   ///             when called as (*pf)(2.0).
-   template <typename PF>
-   class basis : public abstract_basis
+   ///             function, which takes a T and returns a T, or an instance of
+   ///             std::shared_ptr<F>, where type F is a class that overloads
+   ///             operator() to take T and return T. In any event, an
+   ///             instance pf of PF should return a T when called as
+   ///             (*pf)(T(2)).
+   ///
+   /// \tparam T   Scalar type.
+   template <typename PF, typename T = double>
+   class basis : public basic_abstract_basis<T>
    {
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+
       /// A deque is used instead of a vector for storage because make_basis()
       /// function, which calls itself recursively, needs to be able to push
       /// onto the front.
@@ -71,12 +103,13 @@ namespace linreg
       virtual ~basis() = default;
 
       /// \return Value of each basis function at given value of its argument.
-      Eigen::VectorXd operator()(double const x) const override;
+      vector operator()(T const x) const override;
 
-      friend basis make_basis<PF>(PF p);
+      template <typename TPF, typename TT>
+      friend basis<TPF, TT> make_basis(TPF p);
 
-      template <typename TPF, typename... Targs>
-      friend basis<TPF> make_basis(TPF p, Targs... Fargs);
+      template <typename TPF, typename TT, typename... Targs>
+      friend basis<TPF, TT> make_basis(TPF p, Targs... Fargs);
 
       /// \return Number of elements in vector returned by operator().
       unsigned size() const override
@@ -85,11 +118,11 @@ namespace linreg
       }
    };
 
-   template <typename PF>
-   Eigen::VectorXd basis<PF>::operator()(double const x) const
+   template <typename PF, typename T>
+   typename basis<PF, T>::vector basis<PF, T>::operator()(T const x) const
    {
       unsigned const sz = this->size();
-      Eigen::VectorXd result(sz);
+      vector result(sz);
       for (unsigned i = 0; i < sz; ++i) {
          result(i) = (*d_[i])(x);
       }
@@ -106,10 +139,13 @@ namespace linreg
    /// function pointer only when the passed in function has no overloads. So,
    /// for example, the global cos() function delcared in <cmath> will not
    /// allow template-type deduction of PF because cos() has overloads.
-   template <typename PF>
-   basis<PF> make_basis(PF p)
+   ///
+   /// The scalar type T of the basis is double unless specified explicitly
+   /// after PF, as in make_basis<PF, float>(p).
+   template <typename PF, typename T>
+   basis<PF, T> make_basis(PF p)
    {
-      basis<PF> r;
+      basis<PF, T> r;
       r.d_.push_front(p);
       return r;
    }
@@ -126,19 +162,26 @@ namespace linreg
    /// are function pointers, but only when no passed in function has an
    /// overload. For example, the global cos() function delcared in <cmath>
    /// will not allow template-type deduction because cos() has overloads.
-   template <typename PF, typename... Targs>
-   basis<PF> make_basis(PF p, Targs... Fargs)
+   template <typename PF, typename T, typename... Targs>
+   basis<PF, T> make_basis(PF p, Targs... Fargs)
    {
-      basis<PF> r = make_basis(Fargs...); // Recursive call.
+      basis<PF, T> r = make_basis<PF, T>(Fargs...); // Recursive call.
       r.d_.push_front(p);
       return r;
    }
 
    /// Base class for standard bases, such as polynom_basis and fourier_basis.
-   struct standard_basis : public abstract_basis {
+   template <typename T>
+   struct standard_basis : public basic_abstract_basis<T> {
       /// Make sure that descendant's destructor is called.
       virtual ~standard_basis() = default;
 
+      /// \return Indicator of the number of basis functions.
+      unsigned degree() const
+      {
+         return degree_;
+      }
+
    protected:
       /// Indicator of the number of basis functions. For a polynomial, the
       /// number of basis functions is one more than the degree. For a fourier
@@ -152,47 +195,78 @@ namespace linreg
    };
 
    /// Polynomial basis of finite degree.
-   struct polynom_basis : public standard_basis {
+   ///
+   /// Member functions are explicitly instantiated in basis.cpp for float and
+   /// double.
+   template <typename T>
+   struct basic_polynom_basis : public standard_basis<T> {
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
       /// Construct from specified degree of polynomial. The number of basis
       /// functions in the basis will be equal to one more than the degree.
-      polynom_basis(unsigned const d) : standard_basis(d)
+      basic_polynom_basis(unsigned const d) : standard_basis<T>(d)
       {
       }
 
       /// Make sure that descendant's destructor is called.
-      virtual ~polynom_basis() = default;
+      virtual ~basic_polynom_basis() = default;
 
       /// \return Value of each basis function at given value of its argument.
       ///         - Element 0 corresponds to the constant function f(x) = 1;
       ///         - Element 1 corresponds to f(x) = x;
       ///         - Element 2 corresponds to f(x) = x*x;
       ///         - etc.
-      Eigen::VectorXd operator()(double const x) const override;
+      vector operator()(T const x) const override;
+
+      /// Evaluate every basis function at every abscissa, one column at a
+      /// time; column j is column j-1 multiplied elementwise by x.
+      void fill_design(Eigen::Ref<vector const> const &x,
+                       Eigen::Ref<matrix> B) const override;
 
       /// \return One more than degree of polynomial. This is the number of
       ///         elements in the vector returned by operator().
       unsigned size() const override
       {
-         return degree_ + 1;
+         return this->degree_ + 1;
       }
    };
 
+   typedef basic_polynom_basis<float> polynom_basis_f; ///< Single precision.
+   typedef basic_polynom_basis<double> polynom_basis;  ///< Double precision.
+
    /// Fourier basis of finite degree.
-   class fourier_basis : public standard_basis
+   ///
+   /// Member functions are explicitly instantiated in basis.cpp for float and
+   /// double.
+   template <typename T>
+   class basic_fourier_basis : public standard_basis<T>
    {
-      double angfreq_; ///< Angular frequency corresponding to fundamental period.
+      T period_;  ///< Fundamental period.
+      T angfreq_; ///< Angular frequency corresponding to fundamental period.
 
    public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
       /// Construct from specified degree and fundamental period of fourier
       /// basis. The number of basis functions in the basis will be equal to
       /// one more than twice the degree.
-      fourier_basis(unsigned const deg, double fper)
-         : standard_basis(deg), angfreq_(8.0 * atan(1.0) / fper)
+      basic_fourier_basis(unsigned const deg, T fper)
+         : standard_basis<T>(deg)
+         , period_(fper)
+         , angfreq_(T(8.0 * atan(1.0) / fper))
+      {
+      }
+
+      /// \return Fundamental period.
+      T period() const
       {
+         return period_;
       }
 
       /// Make sure that descendant's destructor is called.
-      virtual ~fourier_basis() = default;
+      virtual ~basic_fourier_basis() = default;
 
       /// \return Value of each basis function at given value of its argument.
       ///         - Element 0 corresponds to the constant function f(x) = 1;
@@ -201,16 +275,38 @@ namespace linreg
       ///         - Element 3 corresponds to f(x) = cos(2*x);
       ///         - Element 4 corresponds to f(x) = sin(2*x);
       ///         - etc.
-      Eigen::VectorXd operator()(double const x) const override;
+      vector operator()(T const x) const override;
+
+      /// Evaluate every basis function at every abscissa, one pair of columns
+      /// at a time, with vectorized cos() and sin().
+      void fill_design(Eigen::Ref<vector const> const &x,
+                       Eigen::Ref<matrix> B) const override;
 
       /// \return Number (2*degree + 1) of elements in the vector returned by
       ///         operator().
       unsigned size() const override
       {
-         return 2 * degree_ + 1;
+         return 2 * this->degree_ + 1;
       }
    };
+
+   typedef basic_fourier_basis<float> fourier_basis_f; ///< Single precision.
+   typedef basic_fourier_basis<double> fourier_basis;  ///< Double precision.
+
+   /// Evaluate every basis function at every abscissa.
+   ///
+   /// \param  b  Basis.
+   /// \param  x  Abscissae, one for each data point.
+   /// \return    Design matrix, whose row i is b(x(i)).
+   template <typename T>
+   typename basic_abstract_basis<T>::matrix
+   design_matrix(basic_abstract_basis<T> const &b,
+                 Eigen::Ref<typename basic_abstract_basis<T>::vector const> const &x)
+   {
+      typename basic_abstract_basis<T>::matrix B(x.size(), b.size());
+      b.fill_design(x, B);
+      return B;
+   }
 }
 
 #endif // ndef LINREG_BASIS_HPP
-
@@ -0,0 +1,240 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  batch_fit.cpp
+/// \brief Definition of linreg::basic_batch_fit.
+
+#include <exception> // for exception_ptr
+#include <limits>    // for numeric_limits<>
+#include "batch_fit.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+template <typename T>
+basic_batch_fit<T>::basic_batch_fit(unsigned n)
+   : queued_(0), next_(0), stop_(false), fits_(0)
+   , t0_(chrono::steady_clock::now())
+{
+   if (n == 0) {
+      n = thread::hardware_concurrency();
+   }
+   if (n == 0) {
+      n = 1;
+   }
+   for (unsigned i = 0; i < n; ++i) {
+      workers_.emplace_back(new worker);
+   }
+   for (unsigned i = 0; i < n; ++i) {
+      workers_[i]->th = thread(&basic_batch_fit::loop, this, i);
+   }
+}
+
+template <typename T>
+basic_batch_fit<T>::~basic_batch_fit()
+{
+   {
+      lock_guard<mutex> lk(idle_m_);
+      stop_ = true;
+   }
+   idle_cv_.notify_all();
+   for (auto &w : workers_) {
+      w->th.join();
+   }
+}
+
+template <typename T>
+void basic_batch_fit<T>::push(task t)
+{
+   worker &w = *workers_[next_++ % workers_.size()];
+   {
+      // Increment before the task becomes visible to take(), which
+      // decrements, so that the count never wraps below zero; and increment
+      // under idle_m_ so that a worker about to sleep sees it.
+      lock_guard<mutex> lk(idle_m_);
+      ++queued_;
+   }
+   {
+      lock_guard<mutex> lk(w.m);
+      w.q.push_back(move(t));
+   }
+   idle_cv_.notify_one();
+}
+
+template <typename T>
+bool basic_batch_fit<T>::take(unsigned i, task &t)
+{
+   unsigned const n = workers_.size();
+   for (unsigned j = 0; j < n; ++j) {
+      worker &w = *workers_[(i + j) % n];
+      lock_guard<mutex> lk(w.m);
+      if (!w.q.empty()) {
+         if (j == 0) {
+            t = move(w.q.back());
+            w.q.pop_back();
+         } else {
+            t = move(w.q.front());
+            w.q.pop_front();
+         }
+         --queued_;
+         return true;
+      }
+   }
+   return false;
+}
+
+template <typename T>
+void basic_batch_fit<T>::loop(unsigned i)
+{
+   scratch &s = workers_[i]->s;
+   task t;
+   for (;;) {
+      if (take(i, t)) {
+         t(s);
+         t = nullptr;
+         continue;
+      }
+      unique_lock<mutex> lk(idle_m_);
+      idle_cv_.wait(lk, [this] { return stop_ || queued_ > 0; });
+      if (stop_ && queued_ == 0) {
+         return;
+      }
+   }
+}
+
+template <typename T>
+void basic_batch_fit<T>::solve(scratch &s, basic_abstract_basis<T> const &b,
+                               data const &d, vector &c)
+{
+   unsigned const M = d.rows();
+   unsigned const N = b.size();
+   if (M < N) {
+      throw "batch fit requires at least as many points as basis functions";
+   }
+   if (unsigned(s.B.size()) < M * N) {
+      s.B.resize(M * N);
+   }
+   if (unsigned(s.y.size()) < M) {
+      s.y.resize(M);
+   }
+   if (unsigned(s.work.size()) < N) {
+      s.work.resize(N);
+   }
+   Map<matrix> B(s.B.data(), M, N);
+   Map<vector> y(s.y.data(), M);
+   b.fill_design(d.col(0), B);
+   y = d.col(1);
+   // Householder QR in place: B becomes R above the diagonal and the
+   // essential part of each reflector below it, while y becomes Q^T*y.
+   for (unsigned j = 0; j < N; ++j) {
+      T tau;
+      T beta;
+      B.col(j).tail(M - j).makeHouseholderInPlace(tau, beta);
+      auto const essential = B.col(j).tail(M - j - 1);
+      B.bottomRightCorner(M - j, N - j - 1)
+         .applyHouseholderOnTheLeft(essential, tau, s.work.data());
+      y.tail(M - j).applyHouseholderOnTheLeft(essential, tau, s.work.data());
+      B(j, j) = beta;
+   }
+   if (unsigned(c.size()) != N) {
+      c.resize(N);
+   }
+   // Without pivoting, a tiny diagonal element of R signals that the design
+   // matrix is (nearly) rank-deficient, whereupon back substitution would
+   // return huge coefficients. Fall back then to the minimum-norm solution
+   // by SVD, as for basic_fit.
+   T const tol = B.diagonal().cwiseAbs().maxCoeff() * T(M) *
+                 numeric_limits<T>::epsilon();
+   if (!(B.diagonal().cwiseAbs().minCoeff() > tol)) {
+      b.fill_design(d.col(0), B);
+      c = B.jacobiSvd(ComputeThinU | ComputeThinV).solve(d.col(1));
+      return;
+   }
+   B.topLeftCorner(N, N).template triangularView<Upper>().solveInPlace(
+      y.head(N));
+   c = y.head(N);
+}
+
+template <typename T>
+future<typename basic_batch_fit<T>::fit_type>
+basic_batch_fit<T>::submit(basis_ptr b, data d)
+{
+   auto const p = make_shared<promise<fit_type>>();
+   auto const j = make_shared<job>(job{b, move(d)});
+   push([this, p, j](scratch &s) {
+      try {
+         vector c;
+         solve(s, *j->basis, j->points, c);
+         p->set_value(fit_type::from_coefs(j->basis, c));
+      } catch (...) {
+         p->set_exception(current_exception());
+      }
+      ++fits_;
+   });
+   return p->get_future();
+}
+
+template <typename T>
+batch_stats basic_batch_fit<T>::run(std::vector<job> const &jobs,
+                                    std::vector<vector> &coefs)
+{
+   auto const t0 = chrono::steady_clock::now();
+   size_t const n = jobs.size();
+   coefs.resize(n);
+   size_t const chunk = max<size_t>(1, n / (8 * workers_.size()));
+   size_t const nchunks = (n + chunk - 1) / chunk;
+   mutex m;
+   condition_variable cv;
+   size_t left = nchunks;
+   exception_ptr err;
+   for (size_t b = 0; b < n; b += chunk) {
+      size_t const e = min(n, b + chunk);
+      push([&, b, e](scratch &s) {
+         for (size_t i = b; i < e; ++i) {
+            try {
+               solve(s, *jobs[i].basis, jobs[i].points, coefs[i]);
+            } catch (...) {
+               lock_guard<mutex> lk(m);
+               if (!err) {
+                  err = current_exception();
+               }
+            }
+         }
+         fits_ += e - b;
+         lock_guard<mutex> lk(m);
+         if (--left == 0) {
+            cv.notify_all();
+         }
+      });
+   }
+   {
+      unique_lock<mutex> lk(m);
+      cv.wait(lk, [&] { return left == 0; });
+   }
+   if (err) {
+      rethrow_exception(err);
+   }
+   chrono::duration<double> const dt = chrono::steady_clock::now() - t0;
+   return batch_stats{n, dt.count()};
+}
+
+template <typename T>
+batch_stats basic_batch_fit<T>::stats() const
+{
+   chrono::duration<double> const dt = chrono::steady_clock::now() - t0_;
+   return batch_stats{fits_.load(), dt.count()};
+}
+
+template <typename T>
+void basic_batch_fit<T>::reset_stats()
+{
+   fits_ = 0;
+   t0_ = chrono::steady_clock::now();
+}
+
+template class linreg::basic_batch_fit<float>;
+template class linreg::basic_batch_fit<double>;
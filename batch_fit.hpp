@@ -0,0 +1,163 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  batch_fit.hpp
+/// \brief Declaration of linreg::batch_stats, linreg::basic_batch_fit.
+
+#ifndef LINREG_BATCH_FIT_HPP
+#define LINREG_BATCH_FIT_HPP
+
+#include <atomic>             // for atomic<>
+#include <chrono>             // for steady_clock
+#include <condition_variable> // for condition_variable
+#include <deque>              // for deque<>
+#include <functional>         // for function<>
+#include <future>             // for future<>
+#include <memory>             // for unique_ptr<>
+#include <mutex>              // for mutex
+#include <thread>             // for thread
+#include <vector>             // for vector<>
+#include "fit.hpp"            // for basic_fit
+
+namespace linreg
+{
+   /// Count of fits completed over an interval of wall-clock time.
+   struct batch_stats {
+      unsigned long long fits; ///< Number of fits completed.
+      double seconds;          ///< Elapsed wall-clock time.
+
+      /// \return Number of fits per second.
+      double throughput() const
+      {
+         return seconds > 0.0 ? fits / seconds : 0.0;
+      }
+   };
+
+   /// Engine that performs many independent, small fits on a pool of threads.
+   ///
+   /// Each worker thread owns a deque of tasks; it pops tasks from the back of
+   /// its own deque and, when that is empty, steals from the front of another
+   /// worker's deque. Each worker also owns scratch buffers for the design
+   /// matrix, the ordinates, and the Householder workspace; a buffer grows
+   /// when a fit needs more room than any earlier fit on the same worker, but
+   /// is otherwise reused, and so a fit in steady state allocates nothing but
+   /// its result. (The design matrix is filled by the basis's fill_design(),
+   /// which for a custom basis may allocate.)
+   ///
+   /// Each fit is computed by Householder QR decomposition of the design
+   /// matrix, in place in the scratch buffer, and so requires at least as
+   /// many data points as basis functions. If the design matrix be found
+   /// (nearly) rank-deficient, then the fit falls back to the minimum-norm
+   /// solution by SVD, which allocates.
+   ///
+   /// Member functions are explicitly instantiated in batch_fit.cpp for float
+   /// and double.
+   template <typename T>
+   class basic_batch_fit
+   {
+   public:
+      typedef basic_fit<T> fit_type;                     ///< Type of result.
+      typedef typename fit_type::basis_ptr basis_ptr;    ///< Short hand.
+      typedef typename fit_type::data data;              ///< Short hand.
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
+      /// Basis and data for one fit.
+      struct job {
+         basis_ptr basis; ///< Basis.
+         data points;     ///< Data points, abscissa and ordinate.
+      };
+
+   private:
+      /// Per-worker buffers, reused from one fit to the next.
+      struct scratch {
+         vector B;    ///< Storage for design matrix.
+         vector y;    ///< Storage for ordinates.
+         vector work; ///< Workspace for application of Householder reflection.
+      };
+
+      typedef std::function<void(scratch &)> task; ///< Unit of work.
+
+      /// Worker thread, with its own deque of tasks and its own scratch.
+      struct worker {
+         std::mutex m;       ///< Guard for q.
+         std::deque<task> q; ///< Tasks; owner pops back, thief pops front.
+         scratch s;          ///< Scratch buffers.
+         std::thread th;     ///< Thread.
+      };
+
+      std::vector<std::unique_ptr<worker>> workers_; ///< Pool of workers.
+      std::mutex idle_m_;                ///< Guard for sleeping on idle_cv_.
+      std::condition_variable idle_cv_;  ///< Signal that task is queued.
+      std::atomic<unsigned long> queued_; ///< Number of tasks in deques.
+      std::atomic<unsigned> next_;       ///< Round-robin index for push().
+      bool stop_;                        ///< True when destructor is called.
+
+      std::atomic<unsigned long long> fits_;      ///< Fits since reset.
+      std::chrono::steady_clock::time_point t0_; ///< Time of reset.
+
+      /// Queue task on some worker's deque and wake a sleeping worker.
+      void push(task t);
+
+      /// Take task from back of own deque or from front of another's.
+      bool take(unsigned i, task &t);
+
+      /// Loop run by worker i.
+      void loop(unsigned i);
+
+      /// Compute coefficients for basis b and data d in scratch s.
+      static void solve(scratch &s, basic_abstract_basis<T> const &b,
+                        data const &d, vector &c);
+
+   public:
+      /// Start worker threads.
+      /// \param n  Number of threads; zero means one per hardware thread.
+      basic_batch_fit(unsigned n = 0);
+
+      /// Finish queued tasks, and join worker threads.
+      ~basic_batch_fit();
+
+      basic_batch_fit(basic_batch_fit const &) = delete;
+      basic_batch_fit &operator=(basic_batch_fit const &) = delete;
+
+      /// \return Number of worker threads.
+      unsigned threads() const
+      {
+         return workers_.size();
+      }
+
+      /// Queue one fit.
+      /// \return Future that holds the fit, or the exception thrown by it.
+      std::future<fit_type> submit(basis_ptr b, data d);
+
+      /// Perform every fit in jobs, and block until all are done. Jobs are
+      /// split into chunks, several per worker, so that queuing costs little
+      /// per fit and so that idle workers can steal chunks.
+      ///
+      /// \param  jobs   Basis and data for each fit.
+      /// \param  coefs  On return, coefs[i] holds the coefficients for
+      ///                jobs[i]. Each element is resized only if its size
+      ///                differs, and so a results array reused from one batch
+      ///                to the next is not reallocated.
+      /// \return        Number of fits and elapsed time for this batch.
+      ///
+      /// If any fit throw, then the first exception caught is rethrown after
+      /// every job has been attempted.
+      batch_stats run(std::vector<job> const &jobs, std::vector<vector> &coefs);
+
+      /// \return Number of fits completed, and elapsed time, since
+      ///         construction or since reset_stats().
+      batch_stats stats() const;
+
+      /// Reset count of fits and start of elapsed time.
+      void reset_stats();
+   };
+
+   typedef basic_batch_fit<float> batch_fit_f; ///< Single precision.
+   typedef basic_batch_fit<double> batch_fit;  ///< Double precision.
+}
+
+#endif // ndef LINREG_BATCH_FIT_HPP
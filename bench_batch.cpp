@@ -0,0 +1,66 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bench_batch.cpp
+/// \brief Benchmark of many small fits, serial and on batch_fit.
+
+#include <chrono>   // for steady_clock
+#include <iomanip>  // for setw()
+#include <iostream> // for cout, endl
+#include <memory>   // for make_shared<>()
+#include <random>   // for default_random_engine, uniform_int_distribution<>
+#include <thread>   // for thread
+
+#include "batch_fit.hpp"     // for batch_fit
+#include "fake_data.hpp"     // for fake_data
+#include "sinusoid_func.hpp" // for sinusoid
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+unsigned constexpr J = 50000; // Number of independent series.
+
+int main()
+{
+   default_random_engine gen;
+   uniform_int_distribution<unsigned> npts(30, 200);
+   sinusoid const s(1.0, 1.0, 0.0);
+   batch_fit::basis_ptr const bases[] = {make_shared<polynom_basis>(3),
+                                         make_shared<fourier_basis>(2, 1.0)};
+   vector<batch_fit::job> jobs;
+   jobs.reserve(J);
+   for (unsigned i = 0; i < J; ++i) {
+      double const x1 = 0.01 * (i % 37);
+      fake_data const d(npts(gen), x1, x1 + 1.0, 0.3, s);
+      jobs.push_back(batch_fit::job{bases[i % 2], d.matrix()});
+   }
+
+   auto const t0 = chrono::steady_clock::now();
+   vector<VectorXd> serial(J);
+   for (unsigned i = 0; i < J; ++i) {
+      serial[i] = fit(jobs[i].basis, jobs[i].points).coefs();
+   }
+   chrono::duration<double> const dt = chrono::steady_clock::now() - t0;
+   cout << "series: " << J << "\n\n";
+   cout << "threads   fits/s      max |coef - serial coef|\n";
+   cout << "serial" << setw(12) << unsigned(J / dt.count()) << "\n";
+
+   unsigned const hw = max(1u, thread::hardware_concurrency());
+   vector<VectorXd> coefs;
+   for (unsigned n = 1; n <= hw; n *= 2) {
+      batch_fit bf(n);
+      bf.run(jobs, coefs); // Warm up scratch buffers.
+      batch_stats const st = bf.run(jobs, coefs);
+      double err = 0.0;
+      for (unsigned i = 0; i < J; ++i) {
+         err = max(err, (coefs[i] - serial[i]).cwiseAbs().maxCoeff());
+      }
+      cout << setw(6) << n << setw(12) << unsigned(st.throughput()) << "      "
+           << err << "\n";
+   }
+   cout << endl;
+}
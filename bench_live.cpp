@@ -0,0 +1,137 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bench_live.cpp
+/// \brief Benchmark of read latency under concurrent publication of fits.
+
+#include <algorithm> // for sort()
+#include <atomic>    // for atomic<>
+#include <chrono>    // for steady_clock
+#include <iomanip>   // for setw()
+#include <iostream>  // for cout, endl
+#include <memory>    // for make_shared<>(), shared_ptr<>
+#include <mutex>     // for mutex
+#include <thread>    // for thread
+#include <vector>    // for vector<>
+
+#include "fake_data.hpp"     // for fake_data
+#include "live_fit.hpp"      // for live_fit
+#include "sinusoid_func.hpp" // for sinusoid
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+unsigned constexpr SAMPLES = 200000; // Timed reads per reader thread.
+
+typedef chrono::steady_clock clk;
+
+/// \return Median time in nanoseconds between consecutive calls to
+///         clk::now(), which is subtracted from each timed read.
+double clock_overhead()
+{
+   vector<double> dts(SAMPLES);
+   for (auto &dt : dts) {
+      auto const t0 = clk::now();
+      chrono::duration<double, nano> const d = clk::now() - t0;
+      dt = d.count();
+   }
+   sort(dts.begin(), dts.end());
+   return dts[dts.size() / 2];
+}
+
+/// Run n reader threads, each timing SAMPLES single calls to read(), while a
+/// writer calls write() every millisecond.
+///
+/// \param  ovh  Overhead of clock in nanoseconds, subtracted from each time.
+/// \return 99th-percentile latency of one read in nanoseconds.
+template <typename R, typename W>
+double p99(unsigned n, R read, W write, double ovh)
+{
+   atomic<bool> done(false);
+   thread writer([&] {
+      while (!done) {
+         write();
+         this_thread::sleep_for(chrono::milliseconds(1));
+      }
+   });
+   vector<vector<double>> lat(n);
+   vector<thread> readers;
+   for (unsigned t = 0; t < n; ++t) {
+      readers.emplace_back([&, t] {
+         auto r = read();
+         double sum = 0.0;
+         lat[t].reserve(SAMPLES);
+         for (unsigned s = 0; s < SAMPLES; ++s) {
+            double const x = 0.001 * (s % 32);
+            auto const t0 = clk::now();
+            sum += r(x);
+            chrono::duration<double, nano> const dt = clk::now() - t0;
+            lat[t].push_back(dt.count() - ovh);
+         }
+         if (sum == 0.123) {
+            cout << ""; // Keep sum alive.
+         }
+      });
+   }
+   for (auto &r : readers) {
+      r.join();
+   }
+   done = true;
+   writer.join();
+   vector<double> all;
+   for (auto const &l : lat) {
+      all.insert(all.end(), l.begin(), l.end());
+   }
+   sort(all.begin(), all.end());
+   return all[all.size() * 99 / 100];
+}
+
+int main()
+{
+   fake_data const d(100, 0.0, 1.0, 0.3, sinusoid(1.0, 1.0, 0.0));
+   auto const pb = make_shared<polynom_basis>(3);
+   fit const f(pb, d);
+
+   // Baseline: shared pointer guarded by mutex.
+   mutex m;
+   shared_ptr<fit const> locked = make_shared<fit const>(f);
+   auto locked_read = [&] {
+      return [&](double x) {
+         lock_guard<mutex> lk(m);
+         return (*locked)(x);
+      };
+   };
+   auto locked_write = [&] {
+      auto const p = make_shared<fit const>(f);
+      lock_guard<mutex> lk(m);
+      locked = p;
+   };
+
+   // Baseline: atomic operations on shared pointer.
+   shared_ptr<fit const> shared = make_shared<fit const>(f);
+   auto shared_read = [&] {
+      return [&](double x) { return (*atomic_load(&shared))(x); };
+   };
+   auto shared_write = [&] { atomic_store(&shared, make_shared<fit const>(f)); };
+
+   // Hazard-slot publication.
+   live_fit lf(f);
+   auto live_read = [&] { return lf.make_reader(); };
+   auto live_write = [&] { lf.publish(f); };
+
+   double const ovh = clock_overhead();
+   cout << "p99 read latency (ns) with publication every 1 ms\n";
+   cout << "(each read timed singly, less clock overhead of " << ovh
+        << " ns)\n\n";
+   cout << "readers     mutex  atomic_sp  live_fit\n";
+   unsigned const hw = max(1u, thread::hardware_concurrency());
+   for (unsigned n = 1; n <= 2 * hw && n <= 32; n *= 2) {
+      cout << setw(7) << n << setw(10) << p99(n, locked_read, locked_write, ovh)
+           << setw(11) << p99(n, shared_read, shared_write, ovh) << setw(10)
+           << p99(n, live_read, live_write, ovh) << endl;
+   }
+}
@@ -0,0 +1,75 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bench_model.cpp
+/// \brief Benchmark of loading and evaluating a file of fitted models.
+
+#include <chrono>   // for steady_clock
+#include <fstream>  // for ofstream
+#include <iostream> // for cout, endl
+#include <memory>   // for make_shared<>()
+
+#include "bspline.hpp"    // for bspline_basis
+#include "model_file.hpp" // for write_models(), model_file
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+unsigned constexpr J = 30000; // Number of models in file.
+unsigned constexpr REPS = 20; // Number of repetitions for each timing.
+char const PATH[] = "bench_model.dat"; // Scratch file, removed by make clean.
+
+/// \return Mean time in milliseconds of REPS calls to f.
+template <typename F>
+double time_ms(F f)
+{
+   auto const t0 = chrono::steady_clock::now();
+   for (unsigned i = 0; i < REPS; ++i) {
+      f();
+   }
+   auto const t1 = chrono::steady_clock::now();
+   return chrono::duration<double, milli>(t1 - t0).count() / REPS;
+}
+
+int main()
+{
+   fit::basis_ptr const bases[] = {
+      make_shared<polynom_basis>(3), make_shared<fourier_basis>(4, 1.0),
+      make_shared<bspline_basis>(3, VectorXd::LinSpaced(16, 0.0, 1.0))};
+   std::vector<fit> fits;
+   fits.reserve(J);
+   for (unsigned i = 0; i < J; ++i) {
+      fit::basis_ptr const &b = bases[i % 3];
+      fits.push_back(fit::from_coefs(b, VectorXd::Random(b->size())));
+   }
+   {
+      ofstream os(PATH, ios::binary);
+      write_models(os, fits);
+   }
+
+   // The file was just written, and so it is in the page cache; the timing
+   // of construction is that of mapping and validation, not of disk reads.
+   double const topen = time_ms([] { model_file const mf(PATH); });
+   model_file const mf(PATH);
+   double sum = 0.0;
+   double const teval = time_ms([&] {
+      for (size_t i = 0; i < mf.size(); ++i) {
+         sum += mf[i](0.375);
+      }
+   });
+   double const tfit = time_ms([&] {
+      for (size_t i = 0; i < mf.size(); ++i) {
+         sum += mf[i].to_fit()(0.375);
+      }
+   });
+
+   cout << "models: " << mf.size() << "\n\n";
+   cout << "map and validate file      " << topen << " ms\n";
+   cout << "evaluate every model view  " << teval << " ms\n";
+   cout << "convert every model to fit " << tfit << " ms\n";
+   cout << "(checksum " << sum << ")" << endl;
+}
@@ -0,0 +1,81 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bench_precision.cpp
+/// \brief Benchmark of single, double, and mixed precision fits.
+
+#include <chrono>   // for steady_clock
+#include <iomanip>  // for setw()
+#include <iostream> // for cout, endl
+#include <memory>   // for make_shared<>()
+
+#include "fake_data.hpp"     // for fake_data
+#include "fit.hpp"           // for fourier_basis, polynom_basis, fit
+#include "sinusoid_func.hpp" // for sinusoid
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+unsigned constexpr M = 200000; // Number of fake measurements.
+unsigned constexpr REPS = 5;   // Number of repetitions for each timing.
+
+/// \return Mean time in milliseconds of REPS calls to f.
+template <typename F>
+double time_ms(F f)
+{
+   auto const t0 = chrono::steady_clock::now();
+   for (unsigned i = 0; i < REPS; ++i) {
+      f();
+   }
+   auto const t1 = chrono::steady_clock::now();
+   return chrono::duration<double, milli>(t1 - t0).count() / REPS;
+}
+
+/// Time and compare fits in double, single, and mixed precision for one
+/// basis, given in both precisions.
+void compare(string const &name, fit::basis_ptr b, fit_f::basis_ptr bf,
+             MatrixX2d const &dd)
+{
+   MatrixX2f const df = dd.cast<float>();
+   double const td = time_ms([&] { design_matrix(*b, dd.col(0)); });
+   double const tf = time_ms([&] { design_matrix(*bf, df.col(0)); });
+
+   VectorXd cd, cm;
+   VectorXf cf;
+   fit_solution sol = FIT_SVD;
+   double const sd = time_ms([&] { cd = fit(b, dd).coefs(); });
+   double const sf = time_ms([&] { cf = fit_f(bf, df).coefs(); });
+   double const sm = time_ms([&] {
+      fit const f(b, dd, FIT_SVD_MIXED);
+      cm = f.coefs();
+      sol = f.solution();
+   });
+
+   cout << name << ", " << b->size() << " basis functions\n";
+   cout << "                    double     float     mixed (ms)\n";
+   cout << "design matrix  " << setw(10) << td << setw(10) << tf << "\n";
+   cout << "fit            " << setw(10) << sd << setw(10) << sf << setw(10)
+        << sm << (sol == FIT_SVD_MIXED ? "" : " (fell back to FIT_SVD)")
+        << "\n";
+   cout << "max |coef - double coef|: float "
+        << (cf.cast<double>() - cd).cwiseAbs().maxCoeff() << ", mixed "
+        << (cm - cd).cwiseAbs().maxCoeff() << "\n\n";
+}
+
+int main()
+{
+   fake_data const d(M, 0.0, 1.0, 0.3, sinusoid(1.0, 1.0, 0.0));
+   MatrixX2d const dd = d.matrix();
+   cout << "points: " << M << "\n\n";
+   compare("Fourier, degree 8", make_shared<fourier_basis>(8, 1.0),
+           make_shared<fourier_basis_f>(8, 1.0f), dd);
+   compare("polynomial, degree 5", make_shared<polynom_basis>(5),
+           make_shared<polynom_basis_f>(5), dd);
+   compare("polynomial, degree 8", make_shared<polynom_basis>(8),
+           make_shared<polynom_basis_f>(8), dd);
+   cout << flush;
+}
@@ -0,0 +1,180 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bspline.cpp
+/// \brief Definition of linreg::basic_bspline_basis, linreg::banded_lsq().
+
+#include <cmath>  // for abs(), sqrt()
+#include <limits> // for numeric_limits<>
+#include "bspline.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+
+template <typename T>
+basic_bspline_basis<T>::basic_bspline_basis(unsigned degree,
+                                            vector const &knots)
+   : knots_(knots), degree_(degree), uniform_(false), inv_h_(0)
+{
+   unsigned const k = degree;
+   if (unsigned(knots.size()) < 2 * k + 2) {
+      throw "B-spline basis requires at least 2*degree+2 knots";
+   }
+   for (unsigned i = 1; i < knots.size(); ++i) {
+      if (!(knots(i) >= knots(i - 1))) {
+         throw "B-spline knots must be non-decreasing";
+      }
+   }
+   unsigned const n = size();
+   // On an empty domain, every basis function would be 0/0.
+   if (!(knots(n) > knots(k))) {
+      throw "B-spline knots must satisfy knots(degree) < knots(size())";
+   }
+   T const t0 = knots(k);
+   T const h = (knots(n) - t0) / (n - k);
+   T const tol = 8 * std::numeric_limits<T>::epsilon() *
+                 (std::abs(t0) + std::abs(knots(n)));
+   uniform_ = true;
+   for (unsigned i = k + 1; i < n; ++i) {
+      if (std::abs(knots(i) - (t0 + (i - k) * h)) > tol) {
+         uniform_ = false;
+         break;
+      }
+   }
+   inv_h_ = T(1) / h;
+}
+
+template <typename T>
+unsigned basic_bspline_basis<T>::span(T x) const
+{
+   unsigned const k = degree_;
+   unsigned const n = size();
+   if (!uniform_) {
+      return bspline_span(knots_.data(), n, k, x);
+   }
+   // Clamp before conversion, which is undefined for a value out of range of
+   // unsigned (and for NaN, which here maps to the first span).
+   T u = (x - knots_(k)) * inv_h_;
+   T const top = T(n - k);
+   u = (u > T(0) ? (u < top ? u : top) : T(0));
+   unsigned mu = k + unsigned(u);
+   if (mu > n - 1) {
+      mu = n - 1;
+   }
+   // Correct for rounding in the division.
+   if (mu > k && x < knots_(mu)) {
+      --mu;
+   } else if (mu < n - 1 && x >= knots_(mu + 1)) {
+      ++mu;
+   }
+   return mu;
+}
+
+template <typename T>
+typename basic_bspline_basis<T>::vector basic_bspline_basis<T>::
+operator()(T const x) const
+{
+   vector result = vector::Zero(size());
+   unsigned const mu = span(x);
+   bspline_eval(knots_.data(), degree_, mu, x, result.data() + mu - degree_);
+   return result;
+}
+
+template <typename T>
+void basic_bspline_basis<T>::fill_design(Ref<vector const> const &x,
+                                         Ref<matrix> B) const
+{
+   // Avoid allocation for all but unusually high degree.
+   T small[16];
+   vector large;
+   T *b = small;
+   if (degree_ >= 16) {
+      large.resize(degree_ + 1);
+      b = large.data();
+   }
+   B.setZero();
+   for (unsigned i = 0; i < x.size(); ++i) {
+      unsigned const f = nonzero(x(i), b);
+      for (unsigned j = 0; j <= degree_; ++j) {
+         B(i, f + j) = b[j];
+      }
+   }
+}
+
+template <typename T>
+typename basic_bspline_basis<T>::vector
+linreg::banded_lsq(basic_bspline_basis<T> const &b,
+                   Ref<typename basic_bspline_basis<T>::vector const> const &x,
+                   Ref<typename basic_bspline_basis<T>::vector const> const &y)
+{
+   typedef typename basic_bspline_basis<T>::vector vector;
+   typedef typename basic_bspline_basis<T>::matrix matrix;
+   unsigned const k = b.degree();
+   unsigned const n = b.size();
+   // Lower band of Gram matrix; L(d, j) holds element (j + d, j).
+   matrix L = matrix::Zero(k + 1, n);
+   vector c = vector::Zero(n);
+   vector v(k + 1);
+   for (unsigned i = 0; i < x.size(); ++i) {
+      unsigned const f = b.nonzero(x(i), v.data());
+      for (unsigned p = 0; p <= k; ++p) {
+         for (unsigned q = 0; q <= p; ++q) {
+            L(p - q, f + q) += v(p) * v(q);
+         }
+         c(f + p) += v(p) * y(i);
+      }
+   }
+   // Banded Cholesky factorization in place: G = L*L^T.
+   for (unsigned j = 0; j < n; ++j) {
+      unsigned const p0 = (j > k ? j - k : 0);
+      T d = L(0, j);
+      for (unsigned p = p0; p < j; ++p) {
+         d -= L(j - p, p) * L(j - p, p);
+      }
+      if (!(d > T(0))) {
+         throw "banded Gram matrix is not positive definite";
+      }
+      d = std::sqrt(d);
+      L(0, j) = d;
+      unsigned const i1 = (j + k < n ? j + k : n - 1);
+      for (unsigned i = j + 1; i <= i1; ++i) {
+         T s = L(i - j, j);
+         for (unsigned p = (i > k ? i - k : 0); p < j; ++p) {
+            s -= L(i - p, p) * L(j - p, p);
+         }
+         L(i - j, j) = s / d;
+      }
+   }
+   // Forward substitution, L*z = c.
+   for (unsigned j = 0; j < n; ++j) {
+      T s = c(j);
+      for (unsigned p = (j > k ? j - k : 0); p < j; ++p) {
+         s -= L(j - p, p) * c(p);
+      }
+      c(j) = s / L(0, j);
+   }
+   // Backward substitution, L^T*coefs = z.
+   for (unsigned j = n; j-- > 0;) {
+      T s = c(j);
+      unsigned const i1 = (j + k < n ? j + k : n - 1);
+      for (unsigned i = j + 1; i <= i1; ++i) {
+         s -= L(i - j, j) * c(i);
+      }
+      c(j) = s / L(0, j);
+   }
+   return c;
+}
+
+template class linreg::basic_bspline_basis<float>;
+template class linreg::basic_bspline_basis<double>;
+template bspline_basis_f::vector
+linreg::banded_lsq(bspline_basis_f const &b,
+                   Ref<bspline_basis_f::vector const> const &x,
+                   Ref<bspline_basis_f::vector const> const &y);
+template bspline_basis::vector
+linreg::banded_lsq(bspline_basis const &b,
+                   Ref<bspline_basis::vector const> const &x,
+                   Ref<bspline_basis::vector const> const &y);
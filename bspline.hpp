@@ -0,0 +1,167 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  bspline.hpp
+///
+/// \brief Definition of linreg::bspline_span(), linreg::bspline_eval();
+///        declaration of linreg::basic_bspline_basis, linreg::banded_lsq().
+
+#ifndef LINREG_BSPLINE_HPP
+#define LINREG_BSPLINE_HPP
+
+#include <algorithm> // for upper_bound()
+#include "basis.hpp" // for basic_abstract_basis
+
+namespace linreg
+{
+   /// Find knot span containing x by binary search.
+   ///
+   /// \param  t  Knots, non-decreasing, n + k + 1 in number.
+   /// \param  n  Number of basis functions.
+   /// \param  k  Degree of spline.
+   /// \param  x  Abscissa.
+   /// \return    Index mu in [k, n-1] such that t[mu] <= x < t[mu+1], except
+   ///            that mu is clamped to that range when x lies outside of
+   ///            [t[k], t[n]).
+   template <typename T>
+   unsigned bspline_span(T const *t, unsigned n, unsigned k, T x)
+   {
+      unsigned mu = std::upper_bound(t + k, t + n + 1, x) - t;
+      mu = (mu > k ? mu - 1 : k);
+      return (mu < n ? mu : n - 1);
+   }
+
+   /// Evaluate, by the Cox-de Boor recursion, the k+1 basis functions that
+   /// are nonzero on knot span mu.
+   ///
+   /// \param t   Knots.
+   /// \param k   Degree of spline.
+   /// \param mu  Knot span, as returned by bspline_span().
+   /// \param x   Abscissa.
+   /// \param b   On return, b[j] is the value of basis function mu-k+j.
+   template <typename T>
+   void bspline_eval(T const *t, unsigned k, unsigned mu, T x, T *b)
+   {
+      b[0] = T(1);
+      for (unsigned j = 1; j <= k; ++j) {
+         T saved = T(0);
+         for (unsigned r = 0; r < j; ++r) {
+            T const right = t[mu + r + 1] - x;
+            T const left = x - t[mu + 1 + r - j];
+            T const temp = b[r] / (right + left);
+            b[r] = saved + right * temp;
+            saved = left * temp;
+         }
+         b[j] = saved;
+      }
+   }
+
+   /// B-spline basis of arbitrary degree on a user-supplied knot vector.
+   ///
+   /// Each basis function is nonzero on at most k+1 knot spans, and so, at
+   /// any abscissa, at most k+1 basis functions are nonzero. The design
+   /// matrix is therefore sparse, and its Gram matrix is banded; see
+   /// banded_lsq() and FIT_BANDED.
+   ///
+   /// When the knots from t[k] through t[n] are evenly spaced (as they are
+   /// both for a uniform and for a clamped-uniform knot vector), the knot span
+   /// is found by division rather than by binary search.
+   ///
+   /// Member functions are explicitly instantiated in bspline.cpp for float
+   /// and double.
+   template <typename T>
+   class basic_bspline_basis : public basic_abstract_basis<T>
+   {
+   public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
+   private:
+      vector knots_;    ///< Non-decreasing knots.
+      unsigned degree_; ///< Degree of each polynomial piece.
+      bool uniform_;    ///< True if knots t[k] through t[n] be evenly spaced.
+      T inv_h_;         ///< Reciprocal of spacing when uniform.
+
+   public:
+      /// Construct from degree and knots. The number of basis functions is
+      /// n = knots.size() - degree - 1, which must be at least degree + 1.
+      /// The knots must be non-decreasing, with knots(degree) < knots(n), or
+      /// else an exception is thrown.
+      basic_bspline_basis(unsigned degree, vector const &knots);
+
+      /// Make sure that descendant's destructor is called.
+      virtual ~basic_bspline_basis() = default;
+
+      /// \return Value of each basis function at given value of its argument;
+      ///         all but at most degree()+1 elements are zero.
+      vector operator()(T const x) const override;
+
+      /// Evaluate every basis function at every abscissa, writing only the
+      /// nonzero entries of each row after zeroing B.
+      void fill_design(Eigen::Ref<vector const> const &x,
+                       Eigen::Ref<matrix> B) const override;
+
+      /// \return Number of basis functions.
+      unsigned size() const override
+      {
+         return knots_.size() - degree_ - 1;
+      }
+
+      /// \return Degree of each polynomial piece.
+      unsigned degree() const
+      {
+         return degree_;
+      }
+
+      /// \return Knots.
+      vector const &knots() const
+      {
+         return knots_;
+      }
+
+      /// \return Knot span containing x; see bspline_span().
+      unsigned span(T x) const;
+
+      /// Evaluate only the degree()+1 basis functions that may be nonzero at
+      /// x.
+      ///
+      /// \param  x  Abscissa.
+      /// \param  b  On return, b[j] is the value of basis function f+j.
+      /// \return    Index f of first basis function written to b.
+      unsigned nonzero(T x, T *b) const
+      {
+         unsigned const mu = span(x);
+         bspline_eval(knots_.data(), degree_, mu, x, b);
+         return mu - degree_;
+      }
+   };
+
+   typedef basic_bspline_basis<float> bspline_basis_f; ///< Single precision.
+   typedef basic_bspline_basis<double> bspline_basis;  ///< Double precision.
+
+   /// Least-squares coefficients of a B-spline basis by way of the banded
+   /// normal equations.
+   ///
+   /// The (degree+1)-wide band of the Gram matrix, B^T*B, is accumulated
+   /// from the nonzero entries of each row of B, without forming B, and is
+   /// then factored by banded Cholesky decomposition. For M points, N basis
+   /// functions, and degree k, the cost is O(M*k^2 + N*k^2).
+   ///
+   /// If some basis function have no support among the abscissae, then the
+   /// Gram matrix is singular, and an exception is thrown.
+   ///
+   /// \param  b  B-spline basis.
+   /// \param  x  Abscissa of each data point.
+   /// \param  y  Ordinate of each data point.
+   /// \return    Best-fit coefficients.
+   template <typename T>
+   typename basic_bspline_basis<T>::vector
+   banded_lsq(basic_bspline_basis<T> const &b,
+              Eigen::Ref<typename basic_bspline_basis<T>::vector const> const &x,
+              Eigen::Ref<typename basic_bspline_basis<T>::vector const> const &y);
+}
+
+#endif // ndef LINREG_BSPLINE_HPP
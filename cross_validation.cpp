@@ -0,0 +1,91 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  cross_validation.cpp
+/// \brief Definition of linreg::basic_cross_validation.
+
+#include <cmath>          // for sqrt()
+#include <limits>         // for numeric_limits<>
+#include <Eigen/Cholesky> // for LDLT
+#include <Eigen/SVD>      // for JacobiSVD
+#include "cross_validation.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+
+template <typename T>
+basic_cross_validation<T>::basic_cross_validation(basis_ptr b, data const &d)
+   : basis_(b), B_(design_matrix(*b, d.col(0))), y_(d.col(1))
+{
+}
+
+template <typename T>
+typename basic_cross_validation<T>::vector
+basic_cross_validation<T>::loo_residuals() const
+{
+   JacobiSVD<matrix> const svd(B_, ComputeThinU);
+   // Only the columns of U that correspond to nonzero singular values span
+   // the range of the design matrix.
+   matrix const U = svd.matrixU().leftCols(svd.rank());
+   vector const r = y_ - U * (U.transpose() * y_);
+   vector const h = U.rowwise().squaredNorm();
+   // A point of leverage one determines its own fit, and so its
+   // leave-one-out residual is undefined.
+   T const tol = std::sqrt(std::numeric_limits<T>::epsilon());
+   if (h.size() > 0 && h.maxCoeff() >= T(1) - tol) {
+      throw "leave-one-out residual undefined for point of leverage one";
+   }
+   return r.array() / (T(1) - h.array());
+}
+
+template <typename T>
+T basic_cross_validation<T>::loo() const
+{
+   return loo_residuals().squaredNorm() / y_.size();
+}
+
+template <typename T>
+T basic_cross_validation<T>::kfold(unsigned k) const
+{
+   unsigned const M = B_.rows();
+   if (k < 2 || k > M) {
+      throw "number of folds must be in [2, number of points]";
+   }
+   // Downdate in the orthonormal coordinates of the thin SVD, B = U*S*V^T,
+   // rather than through the Gram matrix, whose condition number is the
+   // square of that of B. With z = U^T*y, the fit to the points outside fold
+   // f has coefficients V*S^-1*w, where (I - U_f^T*U_f)*w = z - U_f^T*y_f,
+   // and so predicts U_f*w at the points in the fold.
+   JacobiSVD<matrix> const svd(B_, ComputeThinU);
+   unsigned const r = svd.rank();
+   matrix const U = svd.matrixU().leftCols(r);
+   vector const z = U.transpose() * y_;
+   // The eigenvalues of I - U_f^T*U_f lie in [0, 1]; as for loo_residuals(),
+   // a pivot below sqrt(eps) means that the fold determines part of the fit.
+   T const tol = std::sqrt(std::numeric_limits<T>::epsilon());
+   T sse = 0;
+   for (unsigned f = 0; f < k; ++f) {
+      unsigned const Mf = (M - f + k - 1) / k; // Number of points in fold.
+      matrix Uf(Mf, r);
+      vector yf(Mf);
+      for (unsigned i = f, j = 0; i < M; i += k, ++j) {
+         Uf.row(j) = U.row(i);
+         yf(j) = y_(i);
+      }
+      matrix A = matrix::Identity(r, r);
+      A.template selfadjointView<Lower>().rankUpdate(Uf.transpose(), T(-1));
+      vector const zf = z - Uf.transpose() * yf;
+      LDLT<matrix> const ldlt(A);
+      if (ldlt.info() != Success || !(ldlt.vectorD().minCoeff() > tol)) {
+         throw "design matrix loses rank after removal of fold";
+      }
+      sse += (yf - Uf * ldlt.solve(zf)).squaredNorm();
+   }
+   return sse / M;
+}
+
+template class linreg::basic_cross_validation<float>;
+template class linreg::basic_cross_validation<double>;
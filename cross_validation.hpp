@@ -0,0 +1,87 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  cross_validation.hpp
+/// \brief Declaration of linreg::basic_cross_validation.
+
+#ifndef LINREG_CROSS_VALIDATION_HPP
+#define LINREG_CROSS_VALIDATION_HPP
+
+#include <memory>     // for shared_ptr<>
+#include "basis.hpp"  // for basic_abstract_basis
+
+namespace linreg
+{
+   /// Cross-validation of the fit of a basis to a collection of data points,
+   /// computed without refitting the basis once for each held-out subset.
+   ///
+   /// The leave-one-out error is obtained in closed form from the diagonal of
+   /// the hat matrix, H = U*U^T, where U is the thin left factor of the
+   /// singular-value decomposition of the design matrix. The k-fold error is
+   /// obtained by downdating I = U^T*U by the contribution of each held-out
+   /// fold in turn, which, unlike downdating the Gram matrix, B^T*B, of the
+   /// design matrix B, does not square the condition number of B.
+   ///
+   /// Member functions are explicitly instantiated in cross_validation.cpp for
+   /// float and double.
+   template <typename T>
+   class basic_cross_validation
+   {
+   public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+      typedef Eigen::Matrix<T, Eigen::Dynamic, 2> data;        ///< Data points.
+
+      /// Shared pointer to basis.
+      typedef std::shared_ptr<basic_abstract_basis<T> const> basis_ptr;
+
+   private:
+      basis_ptr basis_; ///< Shared pointer to basis.
+      matrix B_;        ///< Design matrix; row i is basis at abscissa i.
+      vector y_;        ///< Ordinate of each data point.
+
+   public:
+      /// Construct from basis and data.
+      basic_cross_validation(basis_ptr b, data const &d);
+
+      /// \return Shared pointer to basis.
+      basis_ptr basis() const
+      {
+         return basis_;
+      }
+
+      /// \return Residual of each data point with respect to the fit obtained
+      ///         from all of the other data points; element i is
+      ///         r(i)/(1 - H(i,i)), where r is the residual of the full fit.
+      ///         If any point have leverage H(i,i) indistinguishable from one,
+      ///         as for an interpolating fit, then an exception is thrown.
+      vector loo_residuals() const;
+
+      /// \return Mean squared leave-one-out residual.
+      T loo() const;
+
+      /// \return Mean squared residual of each data point with respect to the
+      ///         fit obtained from the other k-1 folds. Data point i is
+      ///         assigned to fold i%k, so that, for data sorted by abscissa,
+      ///         each fold spans the whole domain.
+      ///
+      /// \param k  Number of folds; must be at least two and no greater than
+      ///           the number of data points.
+      ///
+      /// If the remaining folds fail to determine the fit, so that removal of
+      /// a fold reduces the rank of the design matrix, then an exception is
+      /// thrown.
+      T kfold(unsigned k) const;
+   };
+
+   /// Single precision.
+   typedef basic_cross_validation<float> cross_validation_f;
+
+   /// Double precision.
+   typedef basic_cross_validation<double> cross_validation;
+}
+
+#endif // ndef LINREG_CROSS_VALIDATION_HPP
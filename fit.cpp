@@ -1,4 +1,3 @@
-
 /// Copyright 2016  Thomas E. Vaughan
 ///
 /// The present software is redistributable under the terms of the GNU LESSER
@@ -6,26 +5,149 @@
 /// along with the software.
 ///
 /// \file  fit.cpp
-/// \brief Definition of linreg::fit.
+/// \brief Definition of linreg::basic_fit.
 
+#include <cmath>  // for abs()
+#include <limits> // for numeric_limits<>
 #include "fit.hpp"
+#include "bspline.hpp" // for basic_bspline_basis, banded_lsq()
+#include "ridge.hpp"   // for basic_ridge_path
 
 using namespace Eigen;
 using namespace linreg;
 
-fit::fit(basis_ptr b, Eigen::MatrixX2d const& d, fit_solution s) : basis_(b)
+namespace
+{
+   /// Maximum number of CGLS iterations in FIT_SVD_MIXED.
+   unsigned constexpr MAX_REFINE = 50;
+
+   /// Largest product of the condition number of the design matrix and the
+   /// single-precision epsilon for which FIT_SVD_MIXED is attempted.
+   float constexpr MAX_KAPPA_EPS = 0.25f;
+
+   /// Solve the least-squares problem B*c = y by factoring B in single
+   /// precision and refining c in the precision of T.
+   ///
+   /// B is reduced in single precision to its triangular factor R by
+   /// Householder QR, and the tiny R is decomposed as R = U*S*V^T. Then
+   /// P = V*S^-1 is a right preconditioner for which B*P is orthonormal up to
+   /// the single-precision error, of relative size kappa*eps, where kappa is
+   /// the condition number of B. CGLS on min|B*P*u - y|, computed in the
+   /// precision of T, therefore converges to the least-squares solution in
+   /// the precision of T in a few iterations, each costing two products with
+   /// B. (Unlike refinement on the normal equations, whose rate goes as
+   /// kappa^2*eps, this still converges for moderately ill-conditioned
+   /// bases, such as polynomials of moderate degree.)
+   ///
+   /// \return False without refining if kappa*eps be too large for the
+   ///         single-precision factor to help, or if CGLS fail to converge;
+   ///         otherwise true.
+   template <typename T>
+   bool solve_mixed(Matrix<T, Dynamic, Dynamic> const &B,
+                    Matrix<T, Dynamic, 1> const &y, Matrix<T, Dynamic, 1> &c)
+   {
+      typedef Matrix<T, Dynamic, Dynamic> matrix;
+      typedef Matrix<T, Dynamic, 1> vector;
+      unsigned const N = B.cols();
+      if (B.rows() < N) {
+         return false;
+      }
+      HouseholderQR<MatrixXf> const qr(B.template cast<float>());
+      MatrixXf const R =
+         qr.matrixQR().topRows(N).template triangularView<Upper>();
+      JacobiSVD<MatrixXf> const svd(R, ComputeFullV);
+      VectorXf const &sv = svd.singularValues();
+      float const feps = std::numeric_limits<float>::epsilon();
+      if (!(sv(N - 1) > 0.0f) || sv(0) / sv(N - 1) * feps > MAX_KAPPA_EPS) {
+         return false; // Ill-conditioned or rank-deficient.
+      }
+      matrix const P = svd.matrixV().template cast<T>() *
+                       sv.cwiseInverse().template cast<T>().asDiagonal();
+      // CGLS on A = B*P, starting from c = 0. The step cannot shrink much
+      // below kappa*eps relative to c, the accuracy of any backward-stable
+      // solution; past that, the steps only accumulate rounding error.
+      T const tol = 4 * std::numeric_limits<T>::epsilon() * sv(0) / sv(N - 1);
+      c = vector::Zero(N);
+      vector r = y;
+      vector s = P.transpose() * (B.transpose() * r);
+      vector p = s;
+      T gamma = s.squaredNorm();
+      for (unsigned k = 0; k < MAX_REFINE; ++k) {
+         if (gamma == T(0)) {
+            return true;
+         }
+         vector const Pp = P * p;
+         vector const q = B * Pp;
+         T const alpha = gamma / q.squaredNorm();
+         c += alpha * Pp;
+         r -= alpha * q;
+         if (std::abs(alpha) * Pp.norm() <= tol * c.norm()) {
+            return true;
+         }
+         s = P.transpose() * (B.transpose() * r);
+         T const gnew = s.squaredNorm();
+         p = s + (gnew / gamma) * p;
+         gamma = gnew;
+      }
+      return false;
+   }
+}
+
+template <typename T>
+basic_fit<T>::basic_fit(basis_ptr b, data const &d, fit_solution s)
+   : basis_(b), solution_(s)
 {
-   unsigned const M = d.rows();
-   unsigned const N = b->size();
-   MatrixXd const x = d.col(0);
-   MatrixXd const y = d.col(1);
-   if (s == FIT_SVD) {
-      MatrixXd B(M, N);
-      for (unsigned i = 0; i < M; ++i) {
-         B.row(i) = (*b)(x(i));
+   vector const y = d.col(1);
+   if (s == FIT_SVD || s == FIT_SVD_MIXED) {
+      auto const B = design_matrix(*b, d.col(0));
+      if (s == FIT_SVD_MIXED && solve_mixed(B, y, coefs_)) {
+         solution_ = FIT_SVD_MIXED;
+         return;
       }
       coefs_ = B.jacobiSvd(ComputeThinU | ComputeThinV).solve(y);
+      solution_ = FIT_SVD;
+   } else if (s == FIT_BANDED) {
+      auto const bs = dynamic_cast<basic_bspline_basis<T> const *>(b.get());
+      if (!bs) {
+         throw "banded solution requires B-spline basis";
+      }
+      coefs_ = banded_lsq(*bs, d.col(0), y);
+      solution_ = FIT_BANDED;
    } else {
       throw "simple solution not yet implemented";
    }
 }
+
+template <typename T>
+basic_fit<T>::basic_fit(basis_ptr b, data const &d, T lambda)
+   : basis_(b), solution_(FIT_SVD)
+{
+   if (!(lambda >= T(0))) {
+      throw "regularization strength must be non-negative";
+   }
+   JacobiSVD<matrix> const svd(design_matrix(*b, d.col(0)),
+                               ComputeThinU | ComputeThinV);
+   coefs_ = basic_ridge_path<T>(svd, d.col(1))(lambda).coefs;
+}
+
+template <typename T>
+basic_fit<T>::basic_fit(basis_ptr b, data const &d, JacobiSVD<matrix> &svd)
+   : basis_(b), solution_(FIT_SVD)
+{
+   svd.compute(design_matrix(*b, d.col(0)), ComputeThinU | ComputeThinV);
+   coefs_ = svd.solve(d.col(1));
+}
+
+template <typename T>
+basic_fit<T> basic_fit<T>::from_coefs(basis_ptr b, vector const &c)
+{
+   if (unsigned(c.size()) != b->size()) {
+      throw "number of coefficients differs from size of basis";
+   }
+   basic_fit f(b);
+   f.coefs_ = c;
+   return f;
+}
+
+template class linreg::basic_fit<float>;
+template class linreg::basic_fit<double>;
@@ -1,4 +1,3 @@
-
 /// Copyright 2016  Thomas E. Vaughan
 ///
 /// The present software is redistributable under the terms of the GNU LESSER
@@ -6,14 +5,14 @@
 /// along with the software.
 ///
 /// \file  fit.hpp
-/// \brief Declaration of linreg::fit.
+/// \brief Declaration of linreg::basic_fit.
 
 #ifndef LINREG_FIT_HPP
 #define LINREG_FIT_HPP
 
 #include <memory>    // for shared_ptr<>
 #include <Eigen/SVD> // for MatrixX2d, VectorXd
-#include "basis.hpp" // for abstract_basis
+#include "basis.hpp" // for basic_abstract_basis
 
 namespace linreg
 {
@@ -28,21 +27,71 @@ namespace linreg
       /// Find the best fitting coeffiecients by way of the singular-value
       /// decomposition of the rectangular matrix that is a factor of the
       /// square matrix described above.
-      FIT_SVD
+      FIT_SVD,
+
+      /// Factor the design matrix in single precision, and then recover
+      /// coefficients in the precision of the fit by CGLS iteration on the
+      /// residual, preconditioned by the single-precision factor. If the
+      /// design matrix be too poorly conditioned (roughly, condition number
+      /// beyond 1e6) for the single-precision factor to help, or if the
+      /// iteration fail to converge, then fall back to FIT_SVD; see
+      /// basic_fit::solution().
+      FIT_SVD_MIXED,
+
+      /// Accumulate the banded square matrix described above from the nonzero
+      /// entries of each row of the design matrix, and solve by banded
+      /// Cholesky decomposition; see banded_lsq(). The basis must be a
+      /// basic_bspline_basis.
+      FIT_BANDED
    };
 
    /// Best coefficients for fitting a set of basis functions to a collection
-   /// of data points; an instance of class fit also serves as the
+   /// of data points; an instance of class basic_fit also serves as the
    /// corresponding function object.
-   class fit
+   ///
+   /// Member functions are explicitly instantiated in fit.cpp for float and
+   /// double.
+   ///
+   /// \tparam T  Scalar type of basis, of data, and of coefficients.
+   template <typename T>
+   class basic_fit
    {
-      typedef std::shared_ptr<abstract_basis const> basis_ptr; ///< Short hand.
+   public:
+      typedef T scalar;                                        ///< Scalar type.
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+      typedef Eigen::Matrix<T, Eigen::Dynamic, 2> data;        ///< Data points.
+
+      /// Shared pointer to basis.
+      typedef std::shared_ptr<basic_abstract_basis<T> const> basis_ptr;
+
+   private:
       basis_ptr basis_;       ///< Shared pointer to basis.
-      Eigen::VectorXd coefs_; ///< Best-fit coefficients.
+      vector coefs_;          ///< Best-fit coefficients.
+      fit_solution solution_; ///< Method by which coefs_ were found.
+
+      /// Construct from basis, with coefficients not yet set.
+      basic_fit(basis_ptr b) : basis_(b), solution_(FIT_SVD)
+      {
+      }
 
    public:
       /// Construct from basis, data, and (optionally) the method of fit.
-      fit(basis_ptr b, Eigen::MatrixX2d const &d, fit_solution s = FIT_SVD);
+      basic_fit(basis_ptr b, data const &d, fit_solution s = FIT_SVD);
+
+      /// Construct ridge-regularized fit from basis, data, and regularization
+      /// strength lambda, which penalizes the squared norm of the coefficients
+      /// and must be non-negative. To choose lambda, see basic_ridge_path.
+      basic_fit(basis_ptr b, data const &d, T lambda);
+
+      /// Construct from basis and data by way of the singular-value
+      /// decomposition, as for FIT_SVD, and leave the decomposition in svd, so
+      /// that it can be passed to basic_ridge_path without decomposing again.
+      basic_fit(basis_ptr b, data const &d, Eigen::JacobiSVD<matrix> &svd);
+
+      /// \return Fit with basis b and coefficients c found previously, for
+      ///         example, by basic_ridge_path.
+      static basic_fit from_coefs(basis_ptr b, vector const &c);
 
       /// \return Shared pointer to basis.
       basis_ptr basis() const
@@ -51,18 +100,28 @@ namespace linreg
       }
 
       /// \return Reference to best-fit coefficients.
-      Eigen::VectorXd const &coefs() const
+      vector const &coefs() const
       {
          return coefs_;
       }
 
+      /// \return Method by which coefficients were actually found. This is
+      ///         FIT_SVD when FIT_SVD_MIXED was requested but fell back, and
+      ///         also for a fit made by from_coefs() or by ridge regression.
+      fit_solution solution() const
+      {
+         return solution_;
+      }
+
       /// \return Value of best-fit function at specified argument.
-      double operator()(double x) const
+      T operator()(T x) const
       {
          return coefs_.dot((*basis_)(x));
       }
    };
+
+   typedef basic_fit<float> fit_f; ///< Single precision.
+   typedef basic_fit<double> fit;  ///< Double precision.
 }
 
 #endif // ndef LINREG_FIT_HPP
-
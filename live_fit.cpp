@@ -0,0 +1,75 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  live_fit.cpp
+/// \brief Definition of linreg::basic_live_fit.
+
+#include <thread> // for this_thread::yield()
+#include "live_fit.hpp"
+
+using namespace linreg;
+using namespace std;
+
+template <typename T>
+basic_live_fit<T>::basic_live_fit(fit_type const &f, unsigned n)
+   : cur_(new fit_type(f)), slots_(new slot[n]), nslots_(n)
+{
+   for (unsigned i = 0; i < n; ++i) {
+      slots_[i].hazard.store(nullptr);
+      slots_[i].used.store(false);
+   }
+}
+
+template <typename T>
+basic_live_fit<T>::~basic_live_fit()
+{
+   delete cur_.load();
+}
+
+template <typename T>
+typename basic_live_fit<T>::reader basic_live_fit<T>::make_reader() const
+{
+   for (unsigned i = 0; i < nslots_; ++i) {
+      bool expected = false;
+      if (slots_[i].used.compare_exchange_strong(expected, true)) {
+         return reader(this, &slots_[i]);
+      }
+   }
+   throw "no free reader slot in live fit";
+}
+
+template <typename T>
+typename basic_live_fit<T>::snapshot basic_live_fit<T>::reader::acquire() const
+{
+   fit_type const *p = lf_->cur_.load(memory_order_acquire);
+   for (;;) {
+      // Announce, and then confirm that fit was not replaced before the
+      // announcement became visible to writers.
+      s_->hazard.store(p, memory_order_seq_cst);
+      fit_type const *const q = lf_->cur_.load(memory_order_seq_cst);
+      if (q == p) {
+         return snapshot(s_, p);
+      }
+      p = q;
+   }
+}
+
+template <typename T>
+void basic_live_fit<T>::publish(fit_type const &f)
+{
+   fit_type const *const p = new fit_type(f);
+   lock_guard<mutex> lk(publish_m_);
+   fit_type const *const old = cur_.exchange(p, memory_order_seq_cst);
+   for (unsigned i = 0; i < nslots_; ++i) {
+      while (slots_[i].hazard.load(memory_order_seq_cst) == old) {
+         this_thread::yield();
+      }
+   }
+   delete old;
+}
+
+template class linreg::basic_live_fit<float>;
+template class linreg::basic_live_fit<double>;
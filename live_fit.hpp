@@ -0,0 +1,164 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  live_fit.hpp
+/// \brief Declaration of linreg::basic_live_fit.
+
+#ifndef LINREG_LIVE_FIT_HPP
+#define LINREG_LIVE_FIT_HPP
+
+#include <atomic>  // for atomic<>
+#include <memory>  // for unique_ptr<>
+#include <mutex>   // for mutex
+#include "fit.hpp" // for basic_fit
+
+namespace linreg
+{
+   /// Fit that can be replaced by a writer while many readers evaluate it.
+   ///
+   /// The current fit is held by an atomic pointer. Each reader owns a
+   /// hazard slot, in which it announces the fit that it is reading; a
+   /// writer swaps in the new fit and then frees the old one only after no
+   /// slot announces it. So a reader never takes a lock, never touches a
+   /// reference count shared with other readers, and always sees a
+   /// consistent (basis, coefficients) pair. A read retries only if a
+   /// publication happen between its load of the pointer and its check of
+   /// the announcement; each retry thus implies that some publication
+   /// completed, and so reads are lock-free. They are not wait-free: a reader
+   /// can retry without bound if publications follow one another fast
+   /// enough, though each retry costs only two atomic loads and a store.
+   /// Writers are serialized among themselves, and a writer waits only for
+   /// readers still in the middle of a read of the fit that it replaces.
+   ///
+   /// Every reader must be destroyed before the basic_live_fit.
+   ///
+   /// Member functions are explicitly instantiated in live_fit.cpp for float
+   /// and double.
+   template <typename T>
+   class basic_live_fit
+   {
+   public:
+      typedef basic_fit<T> fit_type; ///< Type of fit.
+
+   private:
+      /// Hazard slot of one reader, padded so that no two slots share a cache
+      /// line.
+      struct slot {
+         std::atomic<fit_type const *> hazard; ///< Fit being read, or null.
+         std::atomic<bool> used;               ///< True if owned by reader.
+         char pad[128 - sizeof(hazard) - sizeof(used)]; ///< Padding.
+      };
+
+      std::atomic<fit_type const *> cur_; ///< Current fit.
+      std::unique_ptr<slot[]> slots_;     ///< Hazard slots.
+      unsigned nslots_;                   ///< Number of hazard slots.
+      std::mutex publish_m_;              ///< Serialization of writers.
+
+   public:
+      /// Guard that keeps a fit from being freed while it is read. Only one
+      /// snapshot per reader may exist at a time.
+      class snapshot
+      {
+         slot *s_;            ///< Hazard slot of reader.
+         fit_type const *p_;  ///< Protected fit.
+
+      public:
+         /// Construct from slot and fit protected by it.
+         snapshot(slot *s, fit_type const *p) : s_(s), p_(p)
+         {
+         }
+
+         snapshot(snapshot &&o) : s_(o.s_), p_(o.p_)
+         {
+            o.s_ = nullptr;
+         }
+
+         snapshot(snapshot const &) = delete;
+         snapshot &operator=(snapshot const &) = delete;
+
+         /// Withdraw announcement, so that fit may be freed.
+         ~snapshot()
+         {
+            if (s_) {
+               s_->hazard.store(nullptr, std::memory_order_release);
+            }
+         }
+
+         /// \return Reference to protected fit.
+         fit_type const &operator*() const
+         {
+            return *p_;
+         }
+
+         /// \return Pointer to protected fit.
+         fit_type const *operator->() const
+         {
+            return p_;
+         }
+      };
+
+      /// Handle through which one thread reads; owns one hazard slot.
+      class reader
+      {
+         basic_live_fit const *lf_; ///< Live fit read.
+         slot *s_;                  ///< Hazard slot owned.
+
+      public:
+         /// Construct from live fit and slot already claimed.
+         reader(basic_live_fit const *lf, slot *s) : lf_(lf), s_(s)
+         {
+         }
+
+         reader(reader &&o) : lf_(o.lf_), s_(o.s_)
+         {
+            o.s_ = nullptr;
+         }
+
+         reader(reader const &) = delete;
+         reader &operator=(reader const &) = delete;
+
+         /// Release hazard slot.
+         ~reader()
+         {
+            if (s_) {
+               s_->used.store(false, std::memory_order_release);
+            }
+         }
+
+         /// \return Guard protecting current fit.
+         snapshot acquire() const;
+
+         /// \return Value of current fit at specified argument.
+         T operator()(T x) const
+         {
+            return (*acquire())(x);
+         }
+      };
+
+      /// Construct from initial fit.
+      /// \param f  Initial fit.
+      /// \param n  Maximum number of readers existing at the same time.
+      basic_live_fit(fit_type const &f, unsigned n = 64);
+
+      /// Free current fit.
+      ~basic_live_fit();
+
+      basic_live_fit(basic_live_fit const &) = delete;
+      basic_live_fit &operator=(basic_live_fit const &) = delete;
+
+      /// \return New reader; throw if every slot be in use.
+      reader make_reader() const;
+
+      /// Replace current fit with copy of f, and free the old one once no
+      /// reader is reading it.
+      void publish(fit_type const &f);
+   };
+
+   typedef basic_live_fit<float> live_fit_f; ///< Single precision.
+   typedef basic_live_fit<double> live_fit;  ///< Double precision.
+}
+
+#endif // ndef LINREG_LIVE_FIT_HPP
@@ -0,0 +1,243 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  model_file.cpp
+///
+/// \brief Definition of linreg::write_models(), linreg::model_view,
+///        linreg::model_file.
+
+#include <cmath>       // for atan(), cos(), sin()
+#include <cstring>     // for memcmp(), memcpy()
+#include <memory>      // for make_shared<>()
+#include <fcntl.h>     // for open()
+#include <sys/mman.h>  // for mmap(), munmap()
+#include <sys/stat.h>  // for fstat()
+#include <unistd.h>    // for close()
+#include "bspline.hpp" // for bspline_basis, bspline_span(), bspline_eval()
+#include "model_file.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+namespace
+{
+   char const MAGIC[8] = "LINREGM";        ///< Identifier at start of file.
+   uint32_t constexpr VERSION = 1;         ///< Version of format.
+   uint32_t constexpr BYTEORD = 0x01020304; ///< Byte-order mark.
+   uint32_t constexpr MAX_DEGREE = 4096;    ///< Largest degree accepted.
+
+   /// Parameters and kind of basis of one fit, gathered before writing.
+   struct params {
+      model_record rec;      ///< Fixed-size part of record.
+      VectorXd values;       ///< Parameters of basis.
+      VectorXd const *coefs; ///< Coefficients.
+   };
+
+   /// \return Parameters of basis of f; throw if basis be of unknown kind.
+   params gather(fit const &f)
+   {
+      abstract_basis const *const b = f.basis().get();
+      params p;
+      p.coefs = &f.coefs();
+      p.rec.ncoefs = f.coefs().size();
+      if (auto const pb = dynamic_cast<polynom_basis const *>(b)) {
+         p.rec.kind = MODEL_POLYNOM;
+         p.rec.degree = pb->degree();
+      } else if (auto const fb = dynamic_cast<fourier_basis const *>(b)) {
+         p.rec.kind = MODEL_FOURIER;
+         p.rec.degree = fb->degree();
+         p.values = VectorXd::Constant(1, fb->period());
+      } else if (auto const bb = dynamic_cast<bspline_basis const *>(b)) {
+         p.rec.kind = MODEL_BSPLINE;
+         p.rec.degree = bb->degree();
+         p.values = bb->knots();
+      } else {
+         throw "cannot write model with basis of unknown kind";
+      }
+      if (p.rec.degree > MAX_DEGREE) {
+         throw "cannot write model with degree beyond limit of format";
+      }
+      p.rec.nparams = p.values.size();
+      return p;
+   }
+
+   /// \return True only if record r have consistent sizes for its kind.
+   bool consistent(model_record const &r)
+   {
+      // Compute in 64 bits so that no sum of 32-bit fields can wrap.
+      uint64_t const k = r.degree;
+      uint64_t const nc = r.ncoefs;
+      uint64_t const np = r.nparams;
+      if (k > MAX_DEGREE || nc == 0) {
+         return false;
+      }
+      switch (r.kind) {
+      case MODEL_POLYNOM:
+         return np == 0 && nc == k + 1;
+      case MODEL_FOURIER:
+         return np == 1 && nc == 2 * k + 1;
+      case MODEL_BSPLINE:
+         return nc >= k + 1 && np == nc + k + 1;
+      default:
+         return false;
+      }
+   }
+}
+
+void linreg::write_models(ostream &os, std::vector<fit> const &fits)
+{
+   std::vector<params> ps;
+   ps.reserve(fits.size());
+   for (auto const &f : fits) {
+      ps.push_back(gather(f));
+   }
+   model_file_header h;
+   memcpy(h.magic, MAGIC, sizeof(h.magic));
+   h.version = VERSION;
+   h.byteord = BYTEORD;
+   h.count = fits.size();
+   os.write(reinterpret_cast<char const *>(&h), sizeof(h));
+   uint64_t off = sizeof(h) + fits.size() * sizeof(uint64_t);
+   for (auto const &p : ps) {
+      os.write(reinterpret_cast<char const *>(&off), sizeof(off));
+      off += sizeof(model_record) +
+             (p.rec.nparams + p.rec.ncoefs) * sizeof(double);
+   }
+   for (auto const &p : ps) {
+      os.write(reinterpret_cast<char const *>(&p.rec), sizeof(p.rec));
+      os.write(reinterpret_cast<char const *>(p.values.data()),
+               p.rec.nparams * sizeof(double));
+      os.write(reinterpret_cast<char const *>(p.coefs->data()),
+               p.rec.ncoefs * sizeof(double));
+   }
+   if (!os) {
+      throw "error writing models";
+   }
+}
+
+double model_view::operator()(double x) const
+{
+   double const *const c = coefs();
+   unsigned const n = size();
+   unsigned const k = degree();
+   switch (kind()) {
+   case MODEL_POLYNOM: {
+      double y = c[n - 1];
+      for (unsigned i = n - 1; i-- > 0;) {
+         y = y * x + c[i];
+      }
+      return y;
+   }
+   case MODEL_FOURIER: {
+      // Same expression as in constructor of fourier_basis.
+      double const w = 8.0 * atan(1.0) / params()[0];
+      double y = c[0];
+      for (unsigned j = 1; j <= k; ++j) {
+         y += c[2 * j - 1] * cos(j * w * x) + c[2 * j] * sin(j * w * x);
+      }
+      return y;
+   }
+   case MODEL_BSPLINE: {
+      double const *const t = params();
+      // Avoid allocation for all but unusually high degree.
+      double small[16];
+      std::vector<double> large;
+      double *b = small;
+      if (k >= 16) {
+         large.resize(k + 1);
+         b = large.data();
+      }
+      unsigned const mu = bspline_span(t, n, k, x);
+      bspline_eval(t, k, mu, x, b);
+      double y = 0.0;
+      for (unsigned j = 0; j <= k; ++j) {
+         y += c[mu - k + j] * b[j];
+      }
+      return y;
+   }
+   }
+   throw "unknown kind of model";
+}
+
+fit model_view::to_fit() const
+{
+   fit::basis_ptr b;
+   switch (kind()) {
+   case MODEL_POLYNOM:
+      b = make_shared<polynom_basis>(degree());
+      break;
+   case MODEL_FOURIER:
+      b = make_shared<fourier_basis>(degree(), params()[0]);
+      break;
+   case MODEL_BSPLINE:
+      b = make_shared<bspline_basis>(
+         degree(), Map<VectorXd const>(params(), nparams()));
+      break;
+   default:
+      throw "unknown kind of model";
+   }
+   return fit::from_coefs(b, Map<VectorXd const>(coefs(), size()));
+}
+
+model_file::model_file(string const &path)
+   : addr_(nullptr), bytes_(0), count_(0)
+{
+   int const fd = open(path.c_str(), O_RDONLY);
+   if (fd < 0) {
+      throw "cannot open model file";
+   }
+   struct stat st;
+   if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(model_file_header)) {
+      close(fd);
+      throw "model file is too short";
+   }
+   bytes_ = st.st_size;
+   addr_ = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr_ == MAP_FAILED) {
+      throw "cannot map model file";
+   }
+   try {
+      auto const h = static_cast<model_file_header const *>(addr_);
+      if (memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+         throw "not a model file";
+      }
+      if (h->byteord != BYTEORD) {
+         throw "model file has foreign byte order";
+      }
+      if (h->version != VERSION) {
+         throw "model file has unsupported version";
+      }
+      uint64_t const index_end = sizeof(*h) + h->count * sizeof(uint64_t);
+      if (h->count > bytes_ / sizeof(uint64_t) || index_end > bytes_) {
+         throw "model file has truncated index";
+      }
+      count_ = h->count;
+      for (size_t i = 0; i < count_; ++i) {
+         uint64_t const off = offset(i);
+         if (off < index_end || off % sizeof(double) != 0 ||
+             off > bytes_ - sizeof(model_record)) {
+            throw "model file has bad offset";
+         }
+         auto const r = reinterpret_cast<model_record const *>(
+            static_cast<char const *>(addr_) + off);
+         uint64_t const n = uint64_t(r->nparams) + r->ncoefs;
+         if (!consistent(*r) ||
+             n > (bytes_ - off - sizeof(model_record)) / sizeof(double)) {
+            throw "model file has bad record";
+         }
+      }
+   } catch (...) {
+      munmap(addr_, bytes_);
+      throw;
+   }
+}
+
+model_file::~model_file()
+{
+   munmap(addr_, bytes_);
+}
@@ -0,0 +1,174 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  model_file.hpp
+///
+/// \brief Declaration of linreg::write_models(), linreg::model_view,
+///        linreg::model_file.
+///
+/// Binary format of a file of fitted models, version 1. Every integer and
+/// every double is stored in the byte order of the machine that wrote the
+/// file, and every record begins on an eight-byte boundary, so that a mapped
+/// file can be read in place.
+///
+/// - model_file_header.
+/// - One uint64_t offset, from the start of the file, for each record.
+/// - For each model, a model_record, followed by nparams doubles of
+///   parameters, followed by ncoefs doubles of coefficients.
+///
+/// Parameters by kind of basis:
+/// - MODEL_POLYNOM: none.
+/// - MODEL_FOURIER: fundamental period.
+/// - MODEL_BSPLINE: knots.
+///
+/// The degree of a basis may not exceed 4096.
+///
+/// When a file is mapped, the sizes in each record are validated, but the
+/// doubles are not; in particular, B-spline knots are used in place without
+/// the check for order made by the constructor of bspline_basis. A corrupt
+/// file can therefore produce NaN from model_view::operator() rather than an
+/// exception, though model_view::to_fit() does check the knots.
+
+#ifndef LINREG_MODEL_FILE_HPP
+#define LINREG_MODEL_FILE_HPP
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint32_t, uint64_t
+#include <ostream> // for ostream
+#include <string>  // for string
+#include <vector>  // for vector<>
+#include "fit.hpp" // for fit
+
+namespace linreg
+{
+   /// Kind of basis of a stored model.
+   enum model_kind {
+      MODEL_POLYNOM = 1, ///< polynom_basis
+      MODEL_FOURIER = 2, ///< fourier_basis
+      MODEL_BSPLINE = 3  ///< bspline_basis
+   };
+
+   /// Header at start of file of models.
+   struct model_file_header {
+      char magic[8];    ///< "LINREGM" with terminating null.
+      uint32_t version; ///< Version of format.
+      uint32_t byteord; ///< 0x01020304 in byte order of writer.
+      uint64_t count;   ///< Number of models.
+   };
+
+   /// Fixed-size part of each record of a model.
+   struct model_record {
+      uint32_t kind;    ///< Kind of basis, a model_kind.
+      uint32_t degree;  ///< Degree of basis.
+      uint32_t nparams; ///< Number of doubles of parameters.
+      uint32_t ncoefs;  ///< Number of doubles of coefficients.
+   };
+
+   /// Write fits to a stream in the binary format described above. Only a fit
+   /// whose basis is a polynom_basis, a fourier_basis, or a bspline_basis can
+   /// be written; for any other basis, an exception is thrown before anything
+   /// is written.
+   void write_models(std::ostream &os, std::vector<fit> const &fits);
+
+   /// Read-only view of one model in a mapped file. The view refers directly
+   /// to the mapped memory, and so it is valid only while the model_file that
+   /// produced it exists.
+   class model_view
+   {
+      model_record const *r_; ///< Record in mapped memory.
+
+   public:
+      /// Construct from record in mapped memory.
+      model_view(model_record const *r) : r_(r)
+      {
+      }
+
+      /// \return Kind of basis.
+      model_kind kind() const
+      {
+         return model_kind(r_->kind);
+      }
+
+      /// \return Degree of basis.
+      unsigned degree() const
+      {
+         return r_->degree;
+      }
+
+      /// \return Number of parameters of basis.
+      unsigned nparams() const
+      {
+         return r_->nparams;
+      }
+
+      /// \return Pointer to parameters of basis.
+      double const *params() const
+      {
+         return reinterpret_cast<double const *>(r_ + 1);
+      }
+
+      /// \return Number of coefficients.
+      unsigned size() const
+      {
+         return r_->ncoefs;
+      }
+
+      /// \return Pointer to coefficients.
+      double const *coefs() const
+      {
+         return params() + r_->nparams;
+      }
+
+      /// \return Value of model at specified argument, computed directly from
+      ///         the mapped parameters and coefficients.
+      double operator()(double x) const;
+
+      /// \return Copy of model as a fit, with a newly allocated basis.
+      fit to_fit() const;
+   };
+
+   /// File of models, mapped read-only into memory. The file is validated once
+   /// on construction, after which each model can be viewed and evaluated in
+   /// place without copying.
+   class model_file
+   {
+      void *addr_;        ///< Start of mapping.
+      std::size_t bytes_; ///< Size of mapping.
+      uint64_t count_;    ///< Number of models.
+
+      /// \return Offset of record i.
+      uint64_t offset(std::size_t i) const
+      {
+         return reinterpret_cast<uint64_t const *>(
+            static_cast<char const *>(addr_) + sizeof(model_file_header))[i];
+      }
+
+   public:
+      /// Map and validate file at specified path.
+      model_file(std::string const &path);
+
+      /// Unmap file.
+      ~model_file();
+
+      model_file(model_file const &) = delete;
+      model_file &operator=(model_file const &) = delete;
+
+      /// \return Number of models in file.
+      std::size_t size() const
+      {
+         return count_;
+      }
+
+      /// \return View of model i.
+      model_view operator[](std::size_t i) const
+      {
+         return model_view(reinterpret_cast<model_record const *>(
+            static_cast<char const *>(addr_) + offset(i)));
+      }
+   };
+}
+
+#endif // ndef LINREG_MODEL_FILE_HPP
@@ -0,0 +1,75 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  multi_fit.cpp
+/// \brief Definition of linreg::basic_multi_fit.
+
+#include <Eigen/SVD> // for JacobiSVD
+#include "multi_fit.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+
+template <typename T>
+basic_multi_fit<T>::basic_multi_fit(basis_ptr b, matrix const &d) : basis_(b)
+{
+   unsigned const D = b->dims();
+   if (unsigned(d.cols()) != D + 1) {
+      throw "number of columns of data must be one more than dimensions";
+   }
+   matrix B(d.rows(), b->size());
+   b->fill_design(d.leftCols(D), B);
+   coefs_ = B.jacobiSvd(ComputeThinU | ComputeThinV).solve(d.col(D));
+}
+
+template <typename T>
+basic_multi_fit<T>::basic_multi_fit(tensor_ptr b,
+                                    std::vector<vector> const &axes,
+                                    vector const &y)
+   : basis_(b)
+{
+   typedef Matrix<T, Dynamic, Dynamic, RowMajor> row_matrix;
+   unsigned const D = b->dims();
+   if (axes.size() != D) {
+      throw "number of axes differs from number of factors";
+   }
+   unsigned post = 1; // Number of grid points along remaining axes.
+   for (auto const &a : axes) {
+      post *= a.size();
+   }
+   if (unsigned(y.size()) != post) {
+      throw "number of ordinates differs from number of grid points";
+   }
+   // Coefficients along axes already processed, followed by ordinates along
+   // axes not yet processed, with the index along last axis varying fastest.
+   vector cur;
+   T const *src = y.data();
+   unsigned pre = 1; // Number of coefficients along axes already processed.
+   for (unsigned d = 0; d < D; ++d) {
+      unsigned const Md = axes[d].size();
+      unsigned const Nd = b->factor(d)->size();
+      post /= Md;
+      JacobiSVD<matrix> const svd(design_matrix(*b->factor(d), axes[d]),
+                                  ComputeThinU | ComputeThinV);
+      unsigned const r = svd.rank();
+      matrix const P = svd.matrixV().leftCols(r) *
+                       svd.singularValues().head(r).cwiseInverse().asDiagonal() *
+                       svd.matrixU().leftCols(r).transpose();
+      vector next(pre * Nd * post);
+      for (unsigned p = 0; p < pre; ++p) {
+         Map<row_matrix const> in(src + p * Md * post, Md, post);
+         Map<row_matrix> out(next.data() + p * Nd * post, Nd, post);
+         out.noalias() = P * in;
+      }
+      cur.swap(next);
+      src = cur.data();
+      pre *= Nd;
+   }
+   coefs_.swap(cur);
+}
+
+template class linreg::basic_multi_fit<float>;
+template class linreg::basic_multi_fit<double>;
@@ -0,0 +1,96 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  multi_fit.hpp
+/// \brief Declaration of linreg::basic_multi_fit.
+
+#ifndef LINREG_MULTI_FIT_HPP
+#define LINREG_MULTI_FIT_HPP
+
+#include <memory>     // for shared_ptr<>
+#include <vector>     // for vector<>
+#include "tensor.hpp" // for basic_abstract_multi_basis, basic_tensor_basis
+
+namespace linreg
+{
+   /// Best coefficients for fitting a set of multivariate basis functions to a
+   /// collection of data points; an instance of class basic_multi_fit also
+   /// serves as the corresponding function object.
+   ///
+   /// Member functions are explicitly instantiated in multi_fit.cpp for float
+   /// and double.
+   ///
+   /// \tparam T  Scalar type of basis, of data, and of coefficients.
+   template <typename T>
+   class basic_multi_fit
+   {
+   public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
+      /// Shared pointer to basis.
+      typedef std::shared_ptr<basic_abstract_multi_basis<T> const> basis_ptr;
+
+      /// Shared pointer to tensor-product basis.
+      typedef std::shared_ptr<basic_tensor_basis<T> const> tensor_ptr;
+
+   private:
+      basis_ptr basis_; ///< Shared pointer to basis.
+      vector coefs_;    ///< Best-fit coefficients.
+
+   public:
+      /// Construct from basis and scattered data by way of the singular-value
+      /// decomposition of the full design matrix.
+      ///
+      /// \param b  Basis.
+      /// \param d  Data, one row per point; the first b->dims() columns
+      ///           contain the coordinates of the point, and the last column
+      ///           contains the ordinate.
+      basic_multi_fit(basis_ptr b, matrix const &d);
+
+      /// Construct from tensor-product basis and data on a full rectilinear
+      /// grid.
+      ///
+      /// Because the design matrix on the grid is the Kronecker product of the
+      /// design matrices of the factors on the corresponding axes, so is its
+      /// pseudo-inverse. So only the small, univariate design matrices are
+      /// decomposed, and the pseudo-inverse of each is applied in turn along
+      /// the corresponding axis of the grid of ordinates. For a 2-D grid of
+      /// M1*M2 points, this costs O(M1*M2*N1), and the M1*M2 by N1*N2 design
+      /// matrix is never formed.
+      ///
+      /// \param b     Tensor-product basis.
+      /// \param axes  Abscissae along each axis of grid, one vector for each
+      ///              factor of b.
+      /// \param y     Ordinate at each point of grid, with the index along the
+      ///              last axis varying fastest.
+      basic_multi_fit(tensor_ptr b, std::vector<vector> const &axes,
+                      vector const &y);
+
+      /// \return Shared pointer to basis.
+      basis_ptr basis() const
+      {
+         return basis_;
+      }
+
+      /// \return Reference to best-fit coefficients.
+      vector const &coefs() const
+      {
+         return coefs_;
+      }
+
+      /// \return Value of best-fit function at specified point.
+      T operator()(Eigen::Ref<vector const> const &x) const
+      {
+         return coefs_.dot((*basis_)(x));
+      }
+   };
+
+   typedef basic_multi_fit<float> multi_fit_f; ///< Single precision.
+   typedef basic_multi_fit<double> multi_fit;  ///< Double precision.
+}
+
+#endif // ndef LINREG_MULTI_FIT_HPP
@@ -0,0 +1,97 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  ridge.cpp
+/// \brief Definition of linreg::basic_ridge_path, linreg::best_gcv().
+
+#include <cmath>  // for isfinite()
+#include <limits> // for numeric_limits<>
+#include "ridge.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+using namespace std;
+
+template <typename T>
+basic_ridge_path<T>::basic_ridge_path(basic_abstract_basis<T> const &b,
+                                      data const &d)
+   : basic_ridge_path(JacobiSVD<matrix>(design_matrix(b, d.col(0)),
+                                        ComputeThinU | ComputeThinV),
+                      d.col(1))
+{
+}
+
+template <typename T>
+typename basic_ridge_path<T>::point basic_ridge_path<T>::
+operator()(T lambda) const
+{
+   if (!(lambda >= T(0))) {
+      throw "regularization strength must be non-negative";
+   }
+   unsigned const n = s_.size();
+   vector w(n); // Filtered inverse singular value.
+   T edf = 0;
+   T rss = rss0_;
+   for (unsigned i = 0; i < n; ++i) {
+      T const s2 = s_(i) * s_(i);
+      if (s2 + lambda > T(0)) {
+         T const f = s2 / (s2 + lambda); // Filter factor.
+         w(i) = s_(i) / (s2 + lambda);
+         edf += f;
+         rss += (1 - f) * (1 - f) * z_(i) * z_(i);
+      } else {
+         // Zero singular value without regularization contributes nothing,
+         // as in the pseudo-inverse.
+         w(i) = 0;
+         rss += z_(i) * z_(i);
+      }
+   }
+   T const dof = m_ - edf;
+   point p;
+   p.lambda = lambda;
+   p.coefs = V_ * w.cwiseProduct(z_);
+   p.edf = edf;
+   p.rss = rss;
+   // An interpolating fit leaves no degrees of freedom for the residual, and
+   // so it cannot be scored.
+   p.gcv = (dof > T(0) ? m_ * rss / (dof * dof)
+                       : numeric_limits<T>::infinity());
+   return p;
+}
+
+template <typename T>
+std::vector<typename basic_ridge_path<T>::point> basic_ridge_path<T>::
+operator()(vector const &lambdas) const
+{
+   std::vector<point> r;
+   r.reserve(lambdas.size());
+   for (unsigned i = 0; i < lambdas.size(); ++i) {
+      r.push_back((*this)(lambdas(i)));
+   }
+   return r;
+}
+
+template <typename T>
+basic_ridge_point<T> const &
+linreg::best_gcv(std::vector<basic_ridge_point<T>> const &p)
+{
+   basic_ridge_point<T> const *best = nullptr;
+   for (auto const &q : p) {
+      if (std::isfinite(q.gcv) && (!best || q.gcv < best->gcv)) {
+         best = &q;
+      }
+   }
+   if (!best) {
+      throw "no point on ridge path has finite GCV score";
+   }
+   return *best;
+}
+
+template class linreg::basic_ridge_path<float>;
+template class linreg::basic_ridge_path<double>;
+template ridge_point_f const &
+linreg::best_gcv(std::vector<ridge_point_f> const &p);
+template ridge_point const &linreg::best_gcv(std::vector<ridge_point> const &p);
@@ -0,0 +1,105 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  ridge.hpp
+/// \brief Declaration of linreg::basic_ridge_point, linreg::basic_ridge_path.
+
+#ifndef LINREG_RIDGE_HPP
+#define LINREG_RIDGE_HPP
+
+#include <vector>    // for vector<>
+#include <Eigen/SVD> // for SVDBase
+#include "basis.hpp" // for basic_abstract_basis
+
+namespace linreg
+{
+   /// Ridge (Tikhonov) regularized solution for one value of the
+   /// regularization strength.
+   template <typename T>
+   struct basic_ridge_point {
+      /// Short hand.
+      typedef typename basic_abstract_basis<T>::vector vector;
+
+      T lambda;     ///< Regularization strength.
+      vector coefs; ///< Coefficients minimizing |B*c-y|^2+lambda*|c|^2.
+      T edf;        ///< Effective degrees of freedom, trace of hat matrix.
+      T rss;        ///< Residual sum of squares.
+      T gcv;        ///< Generalized cross-validation score.
+   };
+
+   typedef basic_ridge_point<float> ridge_point_f; ///< Single precision.
+   typedef basic_ridge_point<double> ridge_point;  ///< Double precision.
+
+   /// Path of ridge-regularized solutions, all obtained from a single
+   /// singular-value decomposition, B = U*S*V^T, of the design matrix. The
+   /// decomposition left by the corresponding constructor of basic_fit can be
+   /// reused, so that fitting and then sweeping lambda decomposes only once.
+   ///
+   /// For strength lambda, the coefficients are V*diag(s/(s^2+lambda))*U^T*y.
+   /// After the decomposition, U^T*y and the residual of the unregularized
+   /// fit are computed once, and so each point on the path costs only O(N^2)
+   /// for the coefficients and O(N) for the effective degrees of freedom, the
+   /// residual, and the GCV score.
+   ///
+   /// Member functions are explicitly instantiated in ridge.cpp for float and
+   /// double.
+   template <typename T>
+   class basic_ridge_path
+   {
+   public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+      typedef Eigen::Matrix<T, Eigen::Dynamic, 2> data;        ///< Data points.
+      typedef basic_ridge_point<T> point;                      ///< Short hand.
+
+   private:
+      matrix V_;   ///< Right singular vectors.
+      vector s_;   ///< Singular values.
+      vector z_;   ///< Projection, U^T*y, of ordinates on U.
+      T rss0_;     ///< Squared norm of y - U*U^T*y, computed directly.
+      unsigned m_; ///< Number of data points.
+
+   public:
+      /// Construct from thin decomposition of design matrix and ordinates.
+      ///
+      /// \tparam D    Type of decomposition, such as JacobiSVD<matrix>, which
+      ///              is left by basic_fit when so requested, or
+      ///              BDCSVD<matrix>.
+      /// \param  svd  Decomposition computed with ComputeThinU|ComputeThinV.
+      /// \param  y    Ordinate of each data point.
+      template <typename D>
+      basic_ridge_path(Eigen::SVDBase<D> const &svd, vector const &y)
+         : V_(svd.matrixV())
+         , s_(svd.singularValues())
+         , z_(svd.matrixU().transpose() * y)
+         , rss0_((y - svd.matrixU() * z_).squaredNorm())
+         , m_(y.size())
+      {
+      }
+
+      /// Construct by decomposing the design matrix of basis b at the
+      /// abscissae of data d.
+      basic_ridge_path(basic_abstract_basis<T> const &b, data const &d);
+
+      /// \return Regularized solution for strength lambda; throw if lambda
+      ///         be negative.
+      point operator()(T lambda) const;
+
+      /// \return Regularized solution for each element of lambdas.
+      std::vector<point> operator()(vector const &lambdas) const;
+   };
+
+   typedef basic_ridge_path<float> ridge_path_f; ///< Single precision.
+   typedef basic_ridge_path<double> ridge_path;  ///< Double precision.
+
+   /// \return Point with smallest finite GCV score; throw if p contain no
+   ///         point with a finite score.
+   template <typename T>
+   basic_ridge_point<T> const &
+   best_gcv(std::vector<basic_ridge_point<T>> const &p);
+}
+
+#endif // ndef LINREG_RIDGE_HPP
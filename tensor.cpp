@@ -0,0 +1,62 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  tensor.cpp
+/// \brief Definition of linreg::basic_tensor_basis.
+
+#include "tensor.hpp"
+
+using namespace Eigen;
+using namespace linreg;
+
+template <typename T>
+basic_tensor_basis<T>::basic_tensor_basis(std::vector<factor_ptr> const &f)
+   : factors_(f), size_(1)
+{
+   if (f.empty()) {
+      throw "tensor basis requires at least one factor";
+   }
+   for (auto const &p : f) {
+      size_ *= p->size();
+   }
+}
+
+template <typename T>
+typename basic_tensor_basis<T>::vector basic_tensor_basis<T>::
+operator()(Ref<vector const> const &x) const
+{
+   vector r = (*factors_[0])(x(0));
+   for (unsigned d = 1; d < factors_.size(); ++d) {
+      vector const f = (*factors_[d])(x(d));
+      vector k(r.size() * f.size());
+      for (unsigned i = 0; i < r.size(); ++i) {
+         k.segment(i * f.size(), f.size()) = r(i) * f;
+      }
+      r.swap(k);
+   }
+   return r;
+}
+
+template <typename T>
+void basic_tensor_basis<T>::fill_design(Ref<matrix const> const &X,
+                                        Ref<matrix> B) const
+{
+   matrix R = design_matrix(*factors_[0], X.col(0));
+   for (unsigned d = 1; d < factors_.size(); ++d) {
+      matrix const F = design_matrix(*factors_[d], X.col(d));
+      matrix K(X.rows(), R.cols() * F.cols());
+      for (unsigned i = 0; i < R.cols(); ++i) {
+         for (unsigned j = 0; j < F.cols(); ++j) {
+            K.col(i * F.cols() + j) = R.col(i).cwiseProduct(F.col(j));
+         }
+      }
+      R.swap(K);
+   }
+   B = R;
+}
+
+template class linreg::basic_tensor_basis<float>;
+template class linreg::basic_tensor_basis<double>;
@@ -0,0 +1,128 @@
+/// Copyright 2016  Thomas E. Vaughan
+///
+/// The present software is redistributable under the terms of the GNU LESSER
+/// GENERAL PUBLIC LICENSE, which must be distributed in the file, 'LICENSE',
+/// along with the software.
+///
+/// \file  tensor.hpp
+///
+/// \brief Definition of linreg::basic_abstract_multi_basis; declaration of
+///        linreg::basic_tensor_basis.
+
+#ifndef LINREG_TENSOR_HPP
+#define LINREG_TENSOR_HPP
+
+#include <memory>    // for shared_ptr<>
+#include <vector>    // for vector<>
+#include "basis.hpp" // for basic_abstract_basis
+
+namespace linreg
+{
+   /// Abstract base class for every type of basis whose functions take more
+   /// than one argument.
+   ///
+   /// Each multivariate basis type must provide an operator() that takes a
+   /// point x, with one element per dimension, and returns a vector of values,
+   /// each corresponding to a different basis function evaluated at x.
+   ///
+   /// \tparam T  Scalar type.
+   template <typename T>
+   struct basic_abstract_multi_basis {
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
+      /// \return Value of each basis function at given point.
+      virtual vector operator()(Eigen::Ref<vector const> const &x) const = 0;
+
+      /// \return Number of elements in vector returned by operator().
+      virtual unsigned size() const = 0;
+
+      /// \return Number of elements in point passed to operator().
+      virtual unsigned dims() const = 0;
+
+      /// Evaluate every basis function at every point. The default
+      /// implementation calls operator() once per point.
+      ///
+      /// \param X  Points, one row per data point and one column per dimension.
+      /// \param B  Design matrix, already of size X.rows() by size(); on
+      ///           return, row i is (*this)(X.row(i)).
+      virtual void fill_design(Eigen::Ref<matrix const> const &X,
+                               Eigen::Ref<matrix> B) const
+      {
+         for (unsigned i = 0; i < X.rows(); ++i) {
+            B.row(i) = (*this)(X.row(i).transpose());
+         }
+      }
+
+      /// Make sure that descendant's destructor is called.
+      virtual ~basic_abstract_multi_basis() = default;
+   };
+
+   /// Single precision.
+   typedef basic_abstract_multi_basis<float> abstract_multi_basis_f;
+
+   /// Double precision.
+   typedef basic_abstract_multi_basis<double> abstract_multi_basis;
+
+   /// Tensor-product basis built from one univariate basis per dimension, such
+   /// as polynom_basis or fourier_basis. Each basis function is the product of
+   /// one function from each factor, and the functions are ordered as in the
+   /// Kronecker product of the factors, with the last factor varying fastest.
+   ///
+   /// Member functions are explicitly instantiated in tensor.cpp for float and
+   /// double.
+   template <typename T>
+   class basic_tensor_basis : public basic_abstract_multi_basis<T>
+   {
+   public:
+      typedef typename basic_abstract_basis<T>::vector vector; ///< Short hand.
+      typedef typename basic_abstract_basis<T>::matrix matrix; ///< Short hand.
+
+      /// Shared pointer to univariate factor.
+      typedef std::shared_ptr<basic_abstract_basis<T> const> factor_ptr;
+
+   private:
+      std::vector<factor_ptr> factors_; ///< One factor for each dimension.
+      unsigned size_; ///< Product of sizes of factors.
+
+   public:
+      /// Construct from one univariate factor for each dimension.
+      basic_tensor_basis(std::vector<factor_ptr> const &f);
+
+      /// Make sure that descendant's destructor is called.
+      virtual ~basic_tensor_basis() = default;
+
+      /// \return Kronecker product of the factors, each evaluated at the
+      ///         corresponding element of x.
+      vector operator()(Eigen::Ref<vector const> const &x) const override;
+
+      /// Evaluate every basis function at every point, by forming, for each
+      /// factor, the column-wise design matrix at the corresponding column of
+      /// X, and then taking the row-wise Kronecker product.
+      void fill_design(Eigen::Ref<matrix const> const &X,
+                       Eigen::Ref<matrix> B) const override;
+
+      /// \return Product of the sizes of the factors.
+      unsigned size() const override
+      {
+         return size_;
+      }
+
+      /// \return Number of factors.
+      unsigned dims() const override
+      {
+         return factors_.size();
+      }
+
+      /// \return Factor for dimension d.
+      factor_ptr const &factor(unsigned d) const
+      {
+         return factors_[d];
+      }
+   };
+
+   typedef basic_tensor_basis<float> tensor_basis_f; ///< Single precision.
+   typedef basic_tensor_basis<double> tensor_basis;  ///< Double precision.
+}
+
+#endif // ndef LINREG_TENSOR_HPP